@@ -0,0 +1,93 @@
+#include <iostream>
+#include <map>
+#include <memory_resource>
+#include <queue>
+#include <set>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "arena.h"
+#include "bench.h"
+
+// the hot loops of days 22, 25, 24 and 12 with the same pmr containers, once on plain new and delete and once
+// on an arena, so the only difference between the two timings is where the memory comes from
+
+// day 22 and 25: a walker that flips cells in a set on every step
+size_t churnSet(unsigned int steps, std::pmr::memory_resource* resource) {
+    std::pmr::set<std::pair<long, long>> cells(resource);
+    std::pair<long, long> position {0, 0};
+    auto direction = 0u;
+    for(auto step = 0u; step < steps; ++step) {
+        if(cells.erase(position) == 0u) {
+            cells.insert(position);
+            direction = (direction + 3) % 4;
+        }
+        else {
+            direction = (direction + 1) % 4;
+        }
+        position.first += direction == 1 ? 1 : direction == 3 ? -1 : 0;
+        position.second += direction == 2 ? 1 : direction == 0 ? -1 : 0;
+    }
+    return cells.size();
+}
+
+// day 24: a priority queue where every candidate carries a copy of what is left
+size_t copyCandidates(unsigned int candidatesToExplore, std::pmr::memory_resource* resource) {
+    using Remaining = std::pmr::vector<unsigned long>;
+    using Candidate = std::tuple<unsigned long, Remaining>;
+    auto isLess = [](const Candidate& lhs, const Candidate& rhs) { return std::get<0>(lhs) < std::get<0>(rhs); };
+    std::priority_queue<Candidate, std::pmr::vector<Candidate>, decltype(isLess)> candidates(isLess, std::pmr::vector<Candidate>(resource));
+
+    Remaining all(resource);
+    for(auto i = 0u; i < 50; ++i) {
+        all.push_back(i);
+    }
+    candidates.emplace(0u, std::move(all));
+    for(auto explored = 0u; explored < candidatesToExplore && !candidates.empty(); ++explored) {
+        const auto strength = std::get<0>(candidates.top());
+        const Remaining remaining(std::get<1>(candidates.top()), resource);
+        candidates.pop();
+        for(auto i = 0u; i < 3 && i < remaining.size(); ++i) {
+            Remaining next(remaining, resource);
+            next.erase(next.begin() + (strength + i) % next.size());
+            candidates.emplace(strength + i + 1, std::move(next));
+        }
+    }
+    return candidates.size();
+}
+
+// day 12: a map of node names to their neighbours, then a copy of it to whittle down
+size_t buildConnections(unsigned int nodes, std::pmr::memory_resource* resource) {
+    std::pmr::map<std::string, std::pmr::vector<std::string>> connections(resource);
+    for(auto node = 0u; node < nodes; ++node) {
+        auto& neighbours = connections[std::to_string(node)];
+        for(auto offset: {1u, 7u, 31u}) {
+            neighbours.push_back(std::to_string((node + offset) % nodes));
+        }
+    }
+    std::pmr::map<std::string, std::pmr::vector<std::string>> copy(connections, resource);
+    return copy.size();
+}
+
+template<typename Workload>
+void compare(const std::string& name, unsigned int size, Workload workload) {
+    constexpr auto REPETITIONS = 5u;
+    std::cout << name << "\n";
+    const auto heap = bench::measure("new/delete", REPETITIONS, [size, &workload]() {
+        bench::doNotOptimize(workload(size, std::pmr::new_delete_resource()));
+    });
+    const auto pooled = bench::measure("arena", REPETITIONS, [size, &workload]() {
+        arena::Arena arena;
+        bench::doNotOptimize(workload(size, arena.resource()));
+    });
+    bench::reportSpeedup(heap, pooled);
+}
+
+int main() {
+    compare("set churn, 2M steps (days 22, 25)", 2'000'000, churnSet);
+    compare("queue of copied vectors, 200k candidates (day 24)", 200'000, copyCandidates);
+    compare("map of string vectors, 100k nodes (day 12)", 100'000, buildConnections);
+    return 0;
+}
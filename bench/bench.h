@@ -0,0 +1,35 @@
+#ifndef BENCH_H_
+#define BENCH_H_
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace bench {
+    // keeps the optimizer from throwing away a result that is otherwise unused
+    template<typename T>
+    void doNotOptimize(const T& value) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    // runs the operation repeatedly and reports the fastest run in milliseconds
+    template<typename Operation>
+    double measure(const std::string& name, unsigned int repetitions, Operation operation) {
+        auto best = std::chrono::duration<double, std::milli>::max();
+        for(auto i = 0u; i < repetitions; ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            operation();
+            best = std::min<std::chrono::duration<double, std::milli>>(best, std::chrono::steady_clock::now() - start);
+        }
+        std::cout << std::left << std::setw(40) << name << std::right << std::setw(12) << std::fixed << std::setprecision(3) << best.count() << " ms\n";
+        return best.count();
+    }
+
+    inline void reportSpeedup(double baseline, double candidate) {
+        std::cout << "speedup: " << std::fixed << std::setprecision(2) << baseline / candidate << "x\n\n";
+    }
+}
+
+#endif
@@ -0,0 +1,51 @@
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "algo.h"
+#include "bench.h"
+
+// a wide spreadsheet row: values that can't divide each other, plus one planted pair like the day 02 input guarantees
+std::vector<int> makeRow(unsigned int columns, int smallest, std::mt19937& generator) {
+    std::uniform_int_distribution<int> distribution(smallest, 2 * smallest - 1);
+    std::vector<int> row;
+    for(auto i = 0u; i < columns; ++i) {
+        row.push_back(distribution(generator));
+    }
+    row[columns / 3] = smallest / 2 - 1;
+    row[2 * columns / 3] = 3 * (smallest / 2 - 1);
+    return row;
+}
+
+void compare(const std::string& name, unsigned int rows, unsigned int columns, int smallest) {
+    std::mt19937 generator(2017);
+    std::vector<std::vector<int>> sheet;
+    for(auto i = 0u; i < rows; ++i) {
+        sheet.push_back(makeRow(columns, smallest, generator));
+    }
+
+    std::cout << name << ": " << rows << " rows of " << columns << " columns\n";
+    const auto quadratic = bench::measure("find_matching_pairs", 1, [&sheet]() {
+        for(const auto& row: sheet) {
+            bench::doNotOptimize(algo::find_matching_pairs(row, [](auto num1, auto num2) { return num1 % num2 == 0; }).size());
+        }
+    });
+    bench::measure("find_divisible_pairs", 3, [&sheet]() {
+        for(const auto& row: sheet) {
+            bench::doNotOptimize(algo::find_divisible_pairs(row).size());
+        }
+    });
+    const auto first = bench::measure("find_first_divisible_pair", 3, [&sheet]() {
+        for(const auto& row: sheet) {
+            bench::doNotOptimize(algo::find_first_divisible_pair(row));
+        }
+    });
+    bench::reportSpeedup(quadratic, first);
+}
+
+int main() {
+    compare("small values (sieve)", 4, 10'000, 20'000);
+    compare("values too big to sieve (divisor buckets)", 4, 10'000, 2'000'000);
+    compare("values too big for either (sorted, skipping past each half)", 4, 10'000, 1'000'000'000);
+    return 0;
+}
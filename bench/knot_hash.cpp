@@ -0,0 +1,69 @@
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+#include "concurrency.h"
+#include "crypto.h"
+
+// the same shape of batch as day 14: one key per row of the disk grid
+std::vector<std::string> makeKeys(const std::string& input, unsigned int count) {
+    std::vector<std::string> keys;
+    for(auto i = 0u; i < count; ++i) {
+        keys.push_back(input + "-" + std::to_string(i));
+    }
+    return keys;
+}
+
+int main() {
+    const auto keys = makeKeys("hfdlxzhv", 128);
+    constexpr auto REPETITIONS = 20u;
+
+    const auto expected = crypto::knotHashBatch(keys);
+    for(auto i = 0u; i < keys.size(); ++i) {
+        if(expected[i] != crypto::knotHash(keys[i])) {
+            std::cout << "knotHashBatch disagrees with knotHash for " << keys[i] << "\n";
+            return 1;
+        }
+    }
+
+    std::cout << "128 key batch\n";
+    const auto legacy = bench::measure("calculateDenseHash per key", REPETITIONS, [&keys]() {
+        for(const auto& key: keys) {
+            bench::doNotOptimize(crypto::calculateDenseHash(key));
+        }
+    });
+    const auto perKey = bench::measure("knotHash per key", REPETITIONS, [&keys]() {
+        for(const auto& key: keys) {
+            bench::doNotOptimize(crypto::knotHash(key));
+        }
+    });
+    const auto batch = bench::measure("knotHashBatch", REPETITIONS, [&keys]() {
+        bench::doNotOptimize(crypto::knotHashBatch(keys));
+    });
+    std::cout << "against calculateDenseHash ";
+    bench::reportSpeedup(legacy, batch);
+    std::cout << "against knotHash ";
+    bench::reportSpeedup(perKey, batch);
+
+    if(crypto::knotHashParallel(keys) != expected) {
+        std::cout << "knotHashParallel disagrees with knotHashBatch\n";
+        return 1;
+    }
+    std::cout << "128 key batch on " << concurrency::sharedPool().size() << " threads\n";
+    const auto parallel = bench::measure("knotHashParallel", REPETITIONS, [&keys]() {
+        bench::doNotOptimize(crypto::knotHashParallel(keys));
+    });
+    std::cout << "against knotHashBatch ";
+    bench::reportSpeedup(batch, parallel);
+
+    // every key but the first run's is a hit, so this is the cost of looking the digests up
+    crypto::HashCache hashCache;
+    const auto cached = bench::measure("HashCache::get", REPETITIONS, [&keys, &hashCache]() {
+        bench::doNotOptimize(hashCache.get(keys));
+    });
+    std::cout << hashCache.getHits() << " hits, " << hashCache.getMisses() << " misses\n";
+    std::cout << "against knotHashBatch ";
+    bench::reportSpeedup(batch, cached);
+    return 0;
+}
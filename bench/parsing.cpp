@@ -0,0 +1,88 @@
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+#include "input.h"
+
+// the parsing path input::toNumbers and input::split(str, ',') used to take, kept here as the baseline
+std::vector<int> legacyToNumbers(const std::string& str) {
+    std::istringstream iss(str);
+    std::vector<std::string> v((std::istream_iterator<std::string>(iss)), std::istream_iterator<std::string>());
+    std::vector<int> out;
+    std::transform(v.begin(), v.end(), std::back_inserter(out), [](const std::string& s) { return std::stoi(s); });
+    return out;
+}
+
+std::vector<int> legacyCommaSeparated(const std::string& str) {
+    std::istringstream iss(str);
+    std::vector<int> out;
+    std::string token;
+    while(std::getline(iss, token, ',')) {
+        out.push_back(std::stoi(token));
+    }
+    return out;
+}
+
+std::string makeSpreadsheet(unsigned int rows, unsigned int columns) {
+    std::mt19937 generator(2017);
+    std::uniform_int_distribution<int> distribution(1, 9999);
+    std::string out;
+    for(auto row = 0u; row < rows; ++row) {
+        for(auto column = 0u; column < columns; ++column) {
+            out += std::to_string(distribution(generator));
+            out += (column + 1 == columns) ? '\n' : '\t';
+        }
+    }
+    return out;
+}
+
+std::string makeLengths(unsigned int count) {
+    std::mt19937 generator(2017);
+    std::uniform_int_distribution<int> distribution(0, 255);
+    std::string out;
+    for(auto i = 0u; i < count; ++i) {
+        out += std::to_string(distribution(generator)) + ",";
+    }
+    return out;
+}
+
+int main() {
+    const auto spreadsheet = makeSpreadsheet(20'000, 64);
+    const auto lines = input::splitLines(spreadsheet);
+    const std::vector<std::string> stringLines(lines.begin(), lines.end());
+
+    const auto legacy = bench::measure("legacy toNumbers (istringstream + stoi)", 5, [&stringLines]() {
+        auto sum = 0l;
+        for(const auto& line: stringLines) {
+            const auto numbers = legacyToNumbers(line);
+            sum += numbers.size();
+        }
+        bench::doNotOptimize(sum);
+    });
+    const auto parsed = bench::measure("parseNumbers into a reused vector", 5, [&lines]() {
+        std::vector<int> numbers;
+        auto sum = 0l;
+        for(const auto& line: lines) {
+            numbers.clear();
+            sum += input::parseNumbers(line, numbers);
+        }
+        bench::doNotOptimize(sum);
+    });
+    bench::reportSpeedup(legacy, parsed);
+
+    const auto lengths = makeLengths(1'000'000);
+    const auto legacySplit = bench::measure("legacy split(',') + stoi", 5, [&lengths]() {
+        bench::doNotOptimize(legacyCommaSeparated(lengths).size());
+    });
+    const auto parsedSplit = bench::measure("parseNumbers(',')", 5, [&lengths]() {
+        std::vector<int> numbers;
+        numbers.reserve(1'000'000);
+        bench::doNotOptimize(input::parseNumbers(lengths, ',', numbers));
+    });
+    bench::reportSpeedup(legacySplit, parsedSplit);
+    return 0;
+}
@@ -0,0 +1,174 @@
+#include "generators.h"
+
+#include <algorithm>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace generators {
+    std::string captcha(size_t scale, uint64_t seed) {
+        Random random(seed);
+        std::string out;
+        out.reserve(scale + 1);
+        for(auto i = 0u; i < scale; ++i) {
+            // a skew towards a few digits so there are plenty of matches to add up
+            out += static_cast<char>('0' + (random.next() % 2 == 0 ? random.between(1, 9) : random.between(1, 3)));
+        }
+        return out + "\n";
+    }
+
+    std::string spreadsheet(size_t scale, uint64_t seed) {
+        constexpr size_t COLUMNS = 16;
+        // primes over 100 can't divide one another, so the only divisible pair is the one put in on purpose
+        // and a multiplier under 100 keeps the one made on purpose from being divisible by any other prime in the row
+        auto isPrime = [](int candidate) {
+            for(auto divisor = 2; divisor * divisor <= candidate; ++divisor) {
+                if(candidate % divisor == 0) {
+                    return false;
+                }
+            }
+            return true;
+        };
+        std::vector<int> primes;
+        for(auto candidate = 101; primes.size() < 200; ++candidate) {
+            if(isPrime(candidate)) {
+                primes.push_back(candidate);
+            }
+        }
+
+        Random random(seed);
+        std::string out;
+        std::vector<int> row;
+        for(auto r = 0u; r < scale; ++r) {
+            row.clear();
+            while(row.size() < COLUMNS - 1) {
+                const auto prime = primes[random.next() % primes.size()];
+                if(std::find(row.begin(), row.end(), prime) == row.end()) {
+                    row.push_back(prime);
+                }
+            }
+            row.push_back(row[random.next() % row.size()] * static_cast<int>(random.between(2, 13)));
+            std::swap(row.back(), row[random.next() % row.size()]);
+            for(auto i = 0u; i < row.size(); ++i) {
+                out += std::to_string(row[i]) + (i + 1 == row.size() ? "\n" : "\t");
+            }
+        }
+        return out;
+    }
+
+    std::string towers(size_t scale, uint64_t seed) {
+        struct Tower {
+            std::string name;
+            int weight;
+            std::vector<size_t> children;
+        };
+        Random random(seed);
+
+        // every tower at the same depth weighs the same, so the whole tree balances until one tower is made heavier
+        std::vector<int> weightsByDepth;
+        for(auto depth = 0u; depth <= scale; ++depth) {
+            weightsByDepth.push_back(static_cast<int>(random.between(10, 99)));
+        }
+
+        std::vector<Tower> towers;
+        auto nameOf = [](size_t index) {
+            std::string name;
+            do {
+                name += static_cast<char>('a' + index % 26);
+                index /= 26;
+            } while(index > 0);
+            return name;
+        };
+        auto build = [&](auto& self, size_t depth) -> size_t {
+            const auto index = towers.size();
+            towers.push_back({nameOf(index), weightsByDepth[depth], {}});
+            if(depth < scale) {
+                for(auto i = 0; i < 3; ++i) {
+                    const auto child = self(self, depth + 1);
+                    towers[index].children.push_back(child);
+                }
+            }
+            return index;
+        };
+        build(build, 0);
+
+        // the heavier tower sits just above the leaves, so it has both a parent to balance against and children that balance
+        auto heavy = towers[0].children[random.next() % 3];
+        while(!towers[towers[heavy].children[0]].children.empty()) {
+            heavy = towers[heavy].children[random.next() % 3];
+        }
+        towers[heavy].weight += static_cast<int>(random.between(1, 9));
+
+        // shuffled so the bottom tower isn't simply the first line
+        std::vector<size_t> order(towers.size());
+        for(auto i = 0u; i < order.size(); ++i) {
+            order[i] = i;
+        }
+        for(auto i = order.size(); i > 1; --i) {
+            std::swap(order[i - 1], order[random.next() % i]);
+        }
+
+        std::string out;
+        for(auto index: order) {
+            const auto& tower = towers[index];
+            out += tower.name + " (" + std::to_string(tower.weight) + ")";
+            for(auto i = 0u; i < tower.children.size(); ++i) {
+                out += (i == 0 ? " -> " : ", ") + towers[tower.children[i]].name;
+            }
+            out += "\n";
+        }
+        return out;
+    }
+
+    std::string particles(size_t scale, uint64_t seed) {
+        Random random(seed);
+        std::string out;
+        // accelerations are never zero on any axis, otherwise a particle can drift towards the origin forever
+        auto acceleration = [&random]() {
+            const auto magnitude = random.between(1, 60);
+            return random.next() % 2 == 0 ? magnitude : -magnitude;
+        };
+        auto triple = [](int64_t x, int64_t y, int64_t z) {
+            return "<" + std::to_string(x) + "," + std::to_string(y) + "," + std::to_string(z) + ">";
+        };
+        for(auto i = 0u; i < scale; ++i) {
+            const auto p = triple(random.between(-400, 400), random.between(-400, 400), random.between(-400, 400));
+            const auto v = triple(random.between(-50, 50), random.between(-50, 50), random.between(-50, 50));
+            const auto a = triple(acceleration(), acceleration(), acceleration());
+            out += "p=" + p + ", v=" + v + ", a=" + a + "\n";
+        }
+        return out;
+    }
+
+    std::string infectionGrid(size_t scale, uint64_t seed) {
+        const auto side = scale | 1u;
+        Random random(seed);
+        std::string out;
+        out.reserve(side * (side + 1));
+        for(auto y = 0u; y < side; ++y) {
+            for(auto x = 0u; x < side; ++x) {
+                out += random.next() % 2 == 0 ? '#' : '.';
+            }
+            out += "\n";
+        }
+        return out;
+    }
+
+    std::string components(size_t scale, uint64_t seed) {
+        // ports are drawn from a range that grows with the count, so the number of bridges grows without exploding
+        const auto maximumPort = static_cast<int64_t>(scale / 2 + 4);
+        Random random(seed);
+        std::set<std::pair<int64_t, int64_t>> chosen;
+        chosen.insert({0, random.between(1, maximumPort)});
+        while(chosen.size() < scale) {
+            const auto a = random.between(0, maximumPort);
+            const auto b = random.between(0, maximumPort);
+            chosen.insert({std::min(a, b), std::max(a, b)});
+        }
+        std::string out;
+        for(const auto& [a, b]: chosen) {
+            out += std::to_string(a) + "/" + std::to_string(b) + "\n";
+        }
+        return out;
+    }
+}
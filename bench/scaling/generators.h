@@ -0,0 +1,44 @@
+#ifndef GENERATORS_H_
+#define GENERATORS_H_
+
+#include <cstdint>
+#include <string>
+
+// puzzle inputs of any size, the same text every time for the same scale and seed
+namespace generators {
+    // splitmix64, so the sequence doesn't depend on how the standard library implements its distributions
+    class Random {
+    public:
+        explicit Random(uint64_t seed) : state(seed) {}
+
+        uint64_t next() {
+            auto z = (state += 0x9e3779b97f4a7c15);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+            return z ^ (z >> 31);
+        }
+
+        // uniform in [low, high]
+        int64_t between(int64_t low, int64_t high) {
+            return low + static_cast<int64_t>(next() % static_cast<uint64_t>(high - low + 1));
+        }
+
+    private:
+        uint64_t state;
+    };
+
+    // scale is the number of digits
+    std::string captcha(size_t scale, uint64_t seed);
+    // scale is the number of rows, each with exactly one evenly divisible pair
+    std::string spreadsheet(size_t scale, uint64_t seed);
+    // scale is the depth of a tree of towers three wide, at least 2, with the weight off on one tower just above the leaves
+    std::string towers(size_t scale, uint64_t seed);
+    // scale is the number of particles
+    std::string particles(size_t scale, uint64_t seed);
+    // scale is the side of a square grid, rounded up to be odd so there is a middle
+    std::string infectionGrid(size_t scale, uint64_t seed);
+    // scale is the number of components
+    std::string components(size_t scale, uint64_t seed);
+}
+
+#endif
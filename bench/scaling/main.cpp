@@ -0,0 +1,115 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "generators.h"
+#include "runner.h"
+
+// runs days from the runner's registry over generated inputs of growing size and prints the timings as CSV
+// growth is the exponent of time against input size between one scale and the next (1 for linear, 2 for quadratic...),
+// so a complexity regression shows up as a jump in that column rather than having to be read off the raw times
+// usage: benchmark [--repetitions N] [day...]
+
+namespace {
+    struct Workload {
+        std::string day;
+        std::vector<size_t> scales;
+        std::string (*generate)(size_t scale, uint64_t seed);
+    };
+
+    const std::vector<Workload> WORKLOADS = {
+        {"01", {10'000, 100'000, 1'000'000, 10'000'000}, generators::captcha},
+        {"02", {1'000, 4'000, 16'000, 64'000}, generators::spreadsheet},
+        {"07", {3, 4, 5, 6, 7}, generators::towers},
+        {"20", {50, 100, 200, 400}, generators::particles},
+        {"22", {25, 101, 401, 1601}, generators::infectionGrid},
+        {"24", {10, 15, 20, 25, 30}, generators::components},
+    };
+
+    constexpr uint64_t SEED = 2017u;
+
+    struct Timing {
+        std::array<runner::PhaseResult, runner::NUMBER_OF_PHASES> phases;
+        double total = std::numeric_limits<double>::max();
+    };
+
+    // the days read input/inputNN.txt from the working directory, so that is where the generated input goes
+    // caches left by a previous run are removed so every repetition parses from scratch
+    Timing runDay(runner::Solver solver, const std::string& day, const std::string& text, unsigned int repetitions) {
+        const auto inputFileName = "input/input" + day + ".txt";
+        std::ofstream(inputFileName, std::ios::trunc) << text;
+
+        Timing best;
+        for(auto i = 0u; i < repetitions; ++i) {
+            std::filesystem::remove(inputFileName + ".cache");
+            std::ostringstream out;
+            runner::Context context(out);
+            solver(context);
+            context.finish();
+
+            auto total = 0.0;
+            for(const auto& phase: context.getResults()) {
+                total += phase.milliseconds;
+            }
+            if(total < best.total) {
+                best = {context.getResults(), total};
+            }
+        }
+        return best;
+    }
+}
+
+int main(int argc, char** argv) {
+    auto repetitions = 3u;
+    std::vector<std::string> days;
+    for(auto i = 1; i < argc; ++i) {
+        const std::string argument = argv[i];
+        if(argument == "--repetitions" && i + 1 < argc) {
+            repetitions = std::stoul(argv[++i]);
+        }
+        else {
+            days.push_back(argument.size() == 1 ? "0" + argument : argument);
+        }
+    }
+
+    const auto workingDirectory = std::filesystem::temp_directory_path() / "aoc-scaling";
+    std::filesystem::create_directories(workingDirectory / "input");
+    std::filesystem::current_path(workingDirectory);
+
+    std::cout << "day,scale,input_bytes,parse_ms,part1_ms,part2_ms,total_ms,growth\n";
+    std::cout << std::fixed << std::setprecision(3);
+    for(const auto& workload: WORKLOADS) {
+        if(!days.empty() && std::find(days.begin(), days.end(), workload.day) == days.end()) {
+            continue;
+        }
+        const auto solver = runner::registry().at(workload.day);
+
+        auto previousSize = size_t{0};
+        auto previousTotal = 0.0;
+        for(auto scale: workload.scales) {
+            const auto text = workload.generate(scale, SEED);
+            const auto timing = runDay(solver, workload.day, text, repetitions);
+
+            std::cout << workload.day << "," << scale << "," << text.size();
+            for(const auto& phase: timing.phases) {
+                std::cout << "," << phase.milliseconds;
+            }
+            std::cout << "," << timing.total << ",";
+            if(previousSize != 0u && previousTotal > 0.0) {
+                std::cout << std::log(timing.total / previousTotal) / std::log(static_cast<double>(text.size()) / previousSize);
+            }
+            std::cout << "\n" << std::flush;
+            previousSize = text.size();
+            previousTotal = timing.total;
+        }
+    }
+    return 0;
+}
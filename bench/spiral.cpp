@@ -0,0 +1,80 @@
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+#include "spiral.h"
+
+// the ring search day 03 used to do, kept here as the baseline: walk outwards a ring at a time until the square is inside
+uint64_t legacyDistance(uint32_t square) {
+    uint64_t level = 1u;
+    uint64_t min = 1u;
+    uint64_t max = 1u;
+    while(square > max) {
+        const auto width = 2 * level + 1;
+        min = max + 1;
+        max += 4 * width - 4;
+        ++level;
+    }
+    const auto width = 2 * level + 1;
+    auto distanceToMidpoint = [square, level](uint64_t n1, uint64_t n2) {
+        const auto midpoint = static_cast<int64_t>((n1 + n2) / 2);
+        return static_cast<uint64_t>(std::abs(midpoint - static_cast<int64_t>(square))) + level;
+    };
+    const auto lowerLeft = max - width + 1;
+    if(square >= lowerLeft) {
+        return distanceToMidpoint(max, lowerLeft);
+    }
+    const auto upperLeft = lowerLeft - width + 1;
+    if(square >= upperLeft) {
+        return distanceToMidpoint(upperLeft, lowerLeft);
+    }
+    const auto upperRight = upperLeft - width + 1;
+    if(square >= upperRight) {
+        return distanceToMidpoint(upperRight, upperLeft);
+    }
+    return distanceToMidpoint(min - 1, upperRight);
+}
+
+std::vector<uint32_t> makeSquares(size_t count, uint32_t largest) {
+    std::mt19937 generator(2017);
+    std::uniform_int_distribution<uint32_t> distribution(1u, largest);
+    std::vector<uint32_t> squares(count);
+    for(auto& square: squares) {
+        square = distribution(generator);
+    }
+    return squares;
+}
+
+int main() {
+    constexpr size_t QUERIES = 100'000'000;
+    constexpr size_t LEGACY_QUERIES = 100'000;
+    const auto squares = makeSquares(QUERIES, 100'000'000u);
+    std::vector<uint32_t> out(QUERIES);
+
+    std::cout << QUERIES << " queries on squares up to 10^8, the ring search only gets the first " << LEGACY_QUERIES << "\n";
+    const auto legacy = bench::measure("ring search", 1, [&squares, &out]() {
+        for(auto i = 0u; i < LEGACY_QUERIES; ++i) {
+            out[i] = static_cast<uint32_t>(legacyDistance(squares[i]));
+        }
+        bench::doNotOptimize(out[0]);
+    });
+    const auto scalar = bench::measure("spiral::distance", 3, [&squares, &out]() {
+        for(auto i = 0u; i < QUERIES; ++i) {
+            out[i] = static_cast<uint32_t>(spiral::distance(squares[i]));
+        }
+        bench::doNotOptimize(out[0]);
+    });
+    const auto batch = bench::measure("spiral::distances", 3, [&squares, &out]() {
+        spiral::distances(squares, out);
+        bench::doNotOptimize(out[0]);
+    });
+
+    // the ring search is scaled up to the full set of queries
+    std::cout << "ring search against closed form per square:\n";
+    bench::reportSpeedup(legacy * QUERIES / LEGACY_QUERIES, scalar);
+    std::cout << "closed form per square against the batch:\n";
+    bench::reportSpeedup(scalar, batch);
+    return 0;
+}
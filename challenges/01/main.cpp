@@ -1,27 +1,228 @@
 #include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
-#include <numeric>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
-#include "algo.h"
 #include "input.h"
+#include "runner.h"
+#include "simd.h"
 
-//a raw loop probably is way more readable in this case, since you loop indexes and (compare index+distance) % size
-//however, I wanted to see what it would be like without raw loops in the code
-//So, I'm instead rotating a copy by the distance, zipping the strings into a pair, and accumulating any pairs that match
+namespace {
 
-auto getSum(const std::string &input, size_t distance=1) {
-    auto next = input;
-    std::rotate(next.rbegin(), next.rbegin() + distance,  next.rend());
+// comparing the captcha against itself shifted by distance is two straight runs with no wrapping:
+// the first n - distance digits against the ones distance further on, then the last distance digits against the start
+// each run is a kernel that compares two buffers a block at a time and adds up the digits that match, with no copies
 
-    auto zipped = algo::zip(input, next);
-    auto addValueIfMatching = [](auto sum, auto zipPair) { return sum + ( zipPair.first == zipPair.second ? zipPair.first - '0' : 0); };
-    return std::accumulate(zipped.begin(), zipped.end(), 0u, addValueIfMatching);
+uint64_t sumMatchingDigitsScalar(const char* a, const char* b, size_t size) {
+    uint64_t sum = 0u;
+    for(auto i = 0u; i < size; ++i) {
+        sum += a[i] == b[i] ? a[i] - '0' : 0;
+    }
+    return sum;
 }
 
-int main() {
-    auto input = input::readSingleLineFile("input/input01.txt");
-    std::cout << getSum(input) << "\n";
-    std::cout << getSum(input, input.size()/2) << "\n";
-    return 0;
-}
\ No newline at end of file
+#ifdef AOC_SIMD
+// matching bytes keep their digit value and the rest become zero, then psadbw adds each group of 8 bytes into a 64 bit lane
+__attribute__((target("sse2")))
+uint64_t sumMatchingDigitsSse2(const char* a, const char* b, size_t size) {
+    const auto zero = _mm_set1_epi8('0');
+    auto sums = _mm_setzero_si128();
+    size_t i = 0u;
+    for(; i + 16 <= size; i += 16) {
+        const auto left = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        const auto right = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        const auto digits = _mm_and_si128(_mm_cmpeq_epi8(left, right), _mm_sub_epi8(left, zero));
+        sums = _mm_add_epi64(sums, _mm_sad_epu8(digits, _mm_setzero_si128()));
+    }
+    sums = _mm_add_epi64(sums, _mm_unpackhi_epi64(sums, sums));
+    return static_cast<uint64_t>(_mm_cvtsi128_si64(sums)) + sumMatchingDigitsScalar(a + i, b + i, size - i);
+}
+
+__attribute__((target("avx2")))
+uint64_t sumMatchingDigitsAvx2(const char* a, const char* b, size_t size) {
+    const auto zero = _mm256_set1_epi8('0');
+    auto sums = _mm256_setzero_si256();
+    size_t i = 0u;
+    for(; i + 32 <= size; i += 32) {
+        const auto left = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        const auto right = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        const auto digits = _mm256_and_si256(_mm256_cmpeq_epi8(left, right), _mm256_sub_epi8(left, zero));
+        sums = _mm256_add_epi64(sums, _mm256_sad_epu8(digits, _mm256_setzero_si256()));
+    }
+    alignas(32) uint64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), sums);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sumMatchingDigitsScalar(a + i, b + i, size - i);
+}
+
+// the compare gives a mask directly, so the subtraction can zero the bytes that don't match as it goes
+__attribute__((target("avx512bw")))
+uint64_t sumMatchingDigitsAvx512(const char* a, const char* b, size_t size) {
+    const auto zero = _mm512_set1_epi8('0');
+    auto sums = _mm512_setzero_si512();
+    size_t i = 0u;
+    for(; i + 64 <= size; i += 64) {
+        const auto left = _mm512_loadu_si512(a + i);
+        const auto right = _mm512_loadu_si512(b + i);
+        const auto digits = _mm512_maskz_sub_epi8(_mm512_cmpeq_epi8_mask(left, right), left, zero);
+        sums = _mm512_add_epi64(sums, _mm512_sad_epu8(digits, _mm512_setzero_si512()));
+    }
+    alignas(64) uint64_t lanes[8];
+    _mm512_store_si512(lanes, sums);
+    uint64_t sum = 0u;
+    for(auto lane: lanes) {
+        sum += lane;
+    }
+    return sum + sumMatchingDigitsScalar(a + i, b + i, size - i);
+}
+#endif
+
+using SumFunction = uint64_t (*)(const char*, const char*, size_t);
+
+// adds up a[i] - '0' wherever a[i] == b[i], for the first size characters of each
+uint64_t sumMatchingDigits(const char* a, const char* b, size_t size) {
+    static const auto sum = simd::select<SumFunction>({
+#ifdef AOC_SIMD
+        {simd::Feature::Avx512bw, sumMatchingDigitsAvx512},
+        {simd::Feature::Avx2, sumMatchingDigitsAvx2},
+        {simd::Feature::Sse2, sumMatchingDigitsSse2},
+#endif
+    }, sumMatchingDigitsScalar);
+    return sum(a, b, size);
+}
+
+uint64_t getSum(std::string_view input, size_t distance=1) {
+    if(input.empty()) {
+        throw std::invalid_argument("Captcha is empty");
+    }
+    distance %= input.size();
+    const auto size = input.size() - distance;
+    return sumMatchingDigits(input.data(), input.data() + distance, size) + sumMatchingDigits(input.data() + size, input.data(), distance);
+}
+
+// inputs bigger than this are streamed rather than mapped, so memory use stays at a couple of chunks
+constexpr uintmax_t STREAMING_THRESHOLD = 256u * 1024 * 1024;
+constexpr size_t STREAMING_CHUNK_SIZE = 1024 * 1024;
+
+// the captcha is the first line of the file without its line ending, the same as the mapped path reads
+size_t getCaptchaLength(const std::string& fileName) {
+    std::ifstream inFile(fileName, std::ios::binary);
+    std::vector<char> buffer(STREAMING_CHUNK_SIZE);
+    size_t length = 0u;
+    while(inFile.read(buffer.data(), buffer.size()) || inFile.gcount() > 0) {
+        const auto end = buffer.begin() + inFile.gcount();
+        const auto newline = std::find(buffer.begin(), end, '\n');
+        length += newline - buffer.begin();
+        if(newline != end) {
+            break;
+        }
+    }
+    // a windows line ending leaves a \r in front of the \n
+    if(length > 0u) {
+        char last = '\0';
+        inFile.clear();
+        inFile.seekg(length - 1);
+        inFile.get(last);
+        if(last == '\r') {
+            --length;
+        }
+    }
+    return length;
+}
+
+// reads one half of the captcha a chunk at a time, keeping the last digit of the previous chunk in front of the new one
+// so the part 1 pairs that straddle two chunks are still next to each other in the buffer
+class HalfReader {
+public:
+    HalfReader(const std::string& fileName, size_t offset) : inFile(fileName, std::ios::binary), buffer(STREAMING_CHUNK_SIZE + 1) {
+        if(!inFile.seekg(offset)) {
+            throw std::runtime_error("Could not read " + fileName);
+        }
+    }
+
+    // reads the next size digits into chunk() and returns the part 1 sum over them
+    uint64_t read(size_t size) {
+        if(!inFile.read(buffer.data() + 1, size)) {
+            throw std::runtime_error("Captcha ended early");
+        }
+        uint64_t sum = 0u;
+        if(first == '\0') {
+            first = buffer[1];
+            sum = sumMatchingDigits(chunk(), chunk() + 1, size - 1);
+        }
+        else {
+            sum = sumMatchingDigits(buffer.data(), chunk(), size);
+        }
+        buffer[0] = buffer[size];
+        return sum;
+    }
+
+    const char* chunk() const { return buffer.data() + 1; }
+    char getFirst() const { return first; }
+    char getLast() const { return buffer[0]; }
+
+private:
+    std::ifstream inFile;
+    std::vector<char> buffer;
+    char first = '\0';
+};
+
+uint64_t sumIfMatching(char a, char b) {
+    return a == b ? a - '0' : 0u;
+}
+
+// both parts in one pass with a reader on each half of the captcha
+// the puzzle promises an even length, so digit i + n/2 of the first half is at the same offset in the second half
+// and every part 2 pair in the second half mirrors one in the first, which is why that sum is doubled
+std::pair<uint64_t, uint64_t> getSumsStreaming(const std::string& fileName) {
+    const auto length = getCaptchaLength(fileName);
+    if(length % 2 != 0) {
+        throw std::invalid_argument("Captcha has an odd number of digits");
+    }
+    const auto half = length / 2;
+    if(half == 0) {
+        return {0u, 0u};
+    }
+
+    HalfReader firstHalf(fileName, 0u);
+    HalfReader secondHalf(fileName, half);
+    uint64_t part1 = 0u;
+    uint64_t halfway = 0u;
+    for(size_t position = 0u; position < half; position += STREAMING_CHUNK_SIZE) {
+        const auto size = std::min(STREAMING_CHUNK_SIZE, half - position);
+        part1 += firstHalf.read(size) + secondHalf.read(size);
+        halfway += sumMatchingDigits(firstHalf.chunk(), secondHalf.chunk(), size);
+    }
+    part1 += sumIfMatching(firstHalf.getLast(), secondHalf.getFirst()) + sumIfMatching(secondHalf.getLast(), firstHalf.getFirst());
+    return {part1, halfway * 2};
+}
+
+void solve(runner::Context& context) {
+    const std::string fileName = "input/input01.txt";
+    if(std::filesystem::file_size(fileName) > STREAMING_THRESHOLD) {
+        context.startPhase(runner::Phase::Part1);
+        const auto [part1, part2] = getSumsStreaming(fileName);
+        context.out << part1 << "\n";
+        context.startPhase(runner::Phase::Part2);
+        context.out << part2 << "\n";
+        return;
+    }
+
+    const input::MappedFile file(fileName);
+    auto input = file.firstLine();
+    if(input.ends_with('\r')) {
+        input.remove_suffix(1);
+    }
+    context.startPhase(runner::Phase::Part1);
+    context.out << getSum(input) << "\n";
+    context.startPhase(runner::Phase::Part2);
+    context.out << getSum(input, input.size()/2) << "\n";
+}
+}
+
+AOC_DAY("01", solve)
@@ -1,29 +1,134 @@
 #include "input.h"
 #include "algo.h"
-#include "assert.h"
+#include "runner.h"
+#include "simd.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <iostream>
-#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
-auto getDifference(const std::vector<int>& numbers) {
-    auto [min,max] = std::minmax_element(numbers.begin(), numbers.end());
-    return *max - *min;
+namespace {
+
+std::pair<int, int> getMinMaxScalar(const int* values, size_t size) {
+    auto [min, max] = std::minmax_element(values, values + size);
+    return {*min, *max};
+}
+
+#ifdef AOC_SIMD
+__attribute__((target("avx2")))
+std::pair<int, int> getMinMaxAvx2(const int* values, size_t size) {
+    if(size < 8) {
+        return getMinMaxScalar(values, size);
+    }
+    auto mins = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values));
+    auto maxes = mins;
+    size_t i = 8u;
+    for(; i + 8 <= size; i += 8) {
+        const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+        mins = _mm256_min_epi32(mins, block);
+        maxes = _mm256_max_epi32(maxes, block);
+    }
+    // the last few values are folded in as one more block that overlaps the previous one
+    if(i != size) {
+        const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + size - 8));
+        mins = _mm256_min_epi32(mins, block);
+        maxes = _mm256_max_epi32(maxes, block);
+    }
+    alignas(32) int minLanes[8];
+    alignas(32) int maxLanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(minLanes), mins);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(maxLanes), maxes);
+    return {*std::min_element(minLanes, minLanes + 8), *std::max_element(maxLanes, maxLanes + 8)};
+}
+#endif
+
+using MinMaxFunction = std::pair<int, int> (*)(const int*, size_t);
+
+// rows must not be empty
+auto getDifference(std::span<const int> numbers) {
+    static const auto minMax = simd::select<MinMaxFunction>({
+#ifdef AOC_SIMD
+        {simd::Feature::Avx2, getMinMaxAvx2},
+#endif
+    }, getMinMaxScalar);
+    const auto [min, max] = minMax(numbers.data(), numbers.size());
+    return static_cast<uint64_t>(static_cast<int64_t>(max) - min);
+}
+
+// sorts the row where it is, which is fine as the difference has already been taken
+auto getEvenlyDivisible(std::span<int> numbers) {
+    const auto pair = algo::find_first_divisible_pair_in_place(numbers);
+    if(!pair) {
+        throw std::invalid_argument("No evenly divisible numbers in a row");
+    }
+    return static_cast<uint64_t>(pair->first / pair->second);
 }
 
-auto getEvenlyDivisible(const std::vector<int>& numbers) { 
-    auto pairs = algo::find_matching_pairs(numbers, [](auto num1, auto num2) { return num1 % num2 == 0; });
-    assert(pairs.size() == 1);
-    return pairs[0].first / pairs[0].second;
+struct Checksums {
+    uint64_t difference = 0u;
+    uint64_t evenlyDivisible = 0u;
+};
+
+// a batch of rows parsed into one contiguous buffer, with where each row starts
+// the buffers are reused from batch to batch so a chunk of the sheet only allocates while they grow
+class RowBatch {
+public:
+    static constexpr size_t MAX_ROWS = 4096;
+
+    void add(std::string_view line) {
+        if(input::parseNumbers(line, values) != 0u) {
+            offsets.push_back(values.size());
+        }
+    }
+
+    bool isFull() const { return offsets.size() > MAX_ROWS; }
+
+    void reduceInto(Checksums& checksums) {
+        const std::span<int> all(values);
+        for(auto row = 0u; row + 1 < offsets.size(); ++row) {
+            const auto numbers = all.subspan(offsets[row], offsets[row + 1] - offsets[row]);
+            checksums.difference += getDifference(numbers);
+            checksums.evenlyDivisible += getEvenlyDivisible(numbers);
+        }
+        values.clear();
+        offsets.assign(1, 0u);
+    }
+
+private:
+    std::vector<int> values;
+    std::vector<size_t> offsets = {0u};
+};
+
+// parsing and both checksums happen together, a batch of rows at a time
+Checksums getChecksums(std::string_view text) {
+    Checksums checksums;
+    RowBatch batch;
+    while(!text.empty()) {
+        const auto newline = text.find('\n');
+        batch.add(text.substr(0, newline));
+        text.remove_prefix(newline == std::string_view::npos ? text.size() : newline + 1);
+        if(batch.isFull()) {
+            batch.reduceInto(checksums);
+        }
+    }
+    batch.reduceInto(checksums);
+    return checksums;
 }
 
-auto getSumOfRowOperations(auto numbers, auto rowOperation){
-    auto rowValues = algo::map(numbers, rowOperation);
-    return std::accumulate(rowValues.begin(), rowValues.end(), 0u);
+void solve(runner::Context& context) {
+    // all of it is timed as part 1, since both sums come out of the same pass
+    context.startPhase(runner::Phase::Part1);
+    const auto total = input::mapReduceLineBlocks("input/input02.txt", getChecksums, Checksums{}, [](Checksums sum, const Checksums& partial) {
+        return Checksums{sum.difference + partial.difference, sum.evenlyDivisible + partial.evenlyDivisible};
+    });
+
+    context.out << total.difference << "\n";
+    context.out << total.evenlyDivisible << "\n";
+}
 }
 
-int main() {
-    auto numbers = algo::map(input::readMultiLineFile("input/input02.txt"), input::toNumbers);
-    std::cout << getSumOfRowOperations(numbers, getDifference) << "\n";
-    std::cout << getSumOfRowOperations(numbers, getEvenlyDivisible) << "\n";
-}
\ No newline at end of file
+AOC_DAY("02", solve)
@@ -1,71 +1,32 @@
 #include <algorithm>
+#include <cstdint>
 #include <iostream>
-#include <map>
-#include <numeric>
 #include <optional>
-#include <tuple>
+#include <stdexcept>
 #include <vector>
 
-using Position = std::pair<int, int>;
+#include "runner.h"
+#include "spiral.h"
 
-auto getWidth(unsigned int level) {
-    return 2 * level + 1;
-}
-
-auto getTargetLevel(unsigned int target) { 
-    auto level = 1u;
-    auto ret = std::make_pair(1u, 1u);
-    while(target > ret.second)
-    {
-        const auto numbers = 4*getWidth(level) - 4;
-        ret = std::make_pair(ret.second+1, ret.second+numbers);
-        ++level;
-    }
-    return std::make_tuple(level, ret.first, ret.second);
-}
-
-auto getNumberOfSteps(unsigned int target){
-    const auto [level, min, max] = getTargetLevel(target);
-    const auto width = getWidth(level);
-
-    auto distanceToMidpoint = [target, level](auto n1, auto n2) { return abs((n1 + n2)/2 - target) + level; };
-    
-    const auto lowerLeft = (max - width + 1 ); 
-    if (target >= lowerLeft) {
-        return distanceToMidpoint(max, lowerLeft);
-    }
-
-    const auto upperLeft = (lowerLeft - width + 1);
-    if (target >= upperLeft) {
-        return distanceToMidpoint(upperLeft, lowerLeft);
-    }
-
-    const auto upperRight = (upperLeft - width + 1);
-    if (target >= upperRight) {
-        return distanceToMidpoint(upperRight, upperLeft);
-    }
-    
-    return distanceToMidpoint(min-1, upperRight);     
-}
+namespace {
 
-Position addPairs(Position p1, Position p2) {
-    return Position(p1.first + p2.first, p1.second + p2.second);
-}
-
-class LookupCache {
+// every value written so far, addressed by its index along the spiral rather than by position
+// ring r (r >= 1) starts at index (2r - 1)^2 and has four sides of 2r cells, each side ending in a corner,
+// and every neighbour of a cell is either just behind it on the same ring or on the same side of the ring inside it,
+// so the neighbours are found with index arithmetic and the values sit in one array that grows a ring at a time
+class SpiralStore {
 public:
-    explicit LookupCache(unsigned int target) : target(target) {
-        cache[Position(0, 0)] = 1;
-    }
-
-    auto calculate(auto p) {
-        auto addPairLookup = [p, this](auto sum, auto m){ return sum + lookup(addPairs(p,m));};
-        const auto sum = std::accumulate(modifiers.begin(), modifiers.end(), 0u, addPairLookup);
-        if (sum > target && !answer.has_value()) {
-            answer = sum;
+    explicit SpiralStore(uint64_t target) : target(target), values{1u} {}
+
+    void addRing() {
+        const auto ring = ++rings;
+        const auto sideLength = 2 * ring;
+        values.reserve(ringStart(ring + 1));
+        for(auto side = 0u; side < 4u; ++side) {
+            for(auto offset = 0u; offset < sideLength; ++offset) {
+                add(calculate(ring, side, offset));
+            }
         }
-        cache[p] = sum;
-        return sum;
     }
 
     auto hasReachedTarget() const {
@@ -75,73 +36,84 @@ public:
     auto getAnswer() const {
         return answer.value_or(0u);
     }
-    
+
 private:
+    static size_t ringStart(size_t ring) {
+        return (2 * ring - 1) * (2 * ring - 1);
+    }
 
-    unsigned int lookup(auto p) const{
-        const auto match = cache.find(p);
-        return (match == cache.end()) ? 0 : match->second;
+    // the values can outgrow 64 bits long before the spiral gets big, so they stick at the maximum instead of wrapping
+    static uint64_t addSaturating(uint64_t a, uint64_t b) {
+        uint64_t sum = 0u;
+        return __builtin_add_overflow(a, b, &sum) ? UINT64_MAX : sum;
     }
 
-    std::map<Position, unsigned int> cache;
-    const unsigned int target;
-    std::optional<unsigned int> answer;
-    const std::vector<Position> modifiers = {{-1, -1}, {-1, 0}, {-1, 1}, {0, -1}, {0, 1}, {1, -1}, {1, 0}, {1, 1} };
-};
+    uint64_t calculate(size_t ring, size_t side, size_t offset) const {
+        const auto sideLength = 2 * ring;
+        const auto position = side * sideLength + offset;
+        const auto current = values.size();
+        uint64_t sum = 0u;
 
-class PositionIterator {
-public:
-    explicit PositionIterator(LookupCache& lookupCache) : lookupCache(lookupCache) {}
-
-    enum class Direction {
-        RIGHT, UP, LEFT, DOWN
-    };
-
-    void updatePosition(Direction direction) {
-        switch (direction) {
-            case Direction::RIGHT: position.first++; break;
-            case Direction::UP: position.second--; break;
-            case Direction::LEFT: position.first--; break;
-            case Direction::DOWN: position.second++; break;
+        // behind on the same ring: the previous cell, and the one before it when the previous one is a corner
+        if(position != 0u) {
+            sum = addSaturating(sum, values[current - 1]);
+        }
+        if(offset == 0u && side != 0u) {
+            sum = addSaturating(sum, values[current - 2]);
+        }
+        // the last two cells of a ring close it up against its first cell
+        if(position + 2 >= 4 * sideLength) {
+            sum = addSaturating(sum, values[ringStart(ring)]);
+        }
+
+        // on the ring inside, cells offset - 2 to offset of the same side, where -1 is the previous side's corner
+        const auto innerSideLength = sideLength - 2;
+        const auto innerStart = ring == 1 ? 0u : ringStart(ring - 1);
+        const auto innerSize = ring == 1 ? 1u : 4 * innerSideLength;
+        const auto first = std::max<int64_t>(static_cast<int64_t>(offset) - 2, -1);
+        const auto last = std::min<int64_t>(static_cast<int64_t>(offset), static_cast<int64_t>(innerSideLength) - 1);
+        for(auto innerOffset = first; innerOffset <= last; ++innerOffset) {
+            const auto innerPosition = static_cast<int64_t>(side * innerSideLength) + innerOffset;
+            const auto wrapped = static_cast<size_t>(innerPosition + static_cast<int64_t>(innerSize)) % innerSize;
+            sum = addSaturating(sum, values[innerStart + wrapped]);
         }
-    } 
+        return sum;
+    }
 
-    void move(Direction direction, unsigned int numberOfTimes=1) {
-        for(unsigned int i = 0u; i < numberOfTimes; ++i){
-            updatePosition(direction);
-            lookupCache.calculate(position);
+    void add(uint64_t value) {
+        if(value > target && !answer.has_value()) {
+            answer = value;
         }
+        values.push_back(value);
     }
 
-private:
-    LookupCache & lookupCache;
-    Position position = Position(0,0);
+    const uint64_t target;
+    std::vector<uint64_t> values;
+    size_t rings = 0u;
+    std::optional<uint64_t> answer;
 };
 
-auto findNextLargestCumulativeValueWritten(unsigned int target) {
-    LookupCache lookupCache(target);
-    PositionIterator position(lookupCache);
-
-    auto level = 1u;
-    while(!lookupCache.hasReachedTarget()) {
-        const auto width = getWidth(level);
-        position.move(PositionIterator::Direction::RIGHT);
-        position.move(PositionIterator::Direction::UP, width - 2);
-        position.move(PositionIterator::Direction::LEFT, width - 1);
-        position.move(PositionIterator::Direction::DOWN, width - 1);
-        position.move(PositionIterator::Direction::RIGHT, width - 1);
-        level++;
+auto findNextLargestCumulativeValueWritten(uint64_t target) {
+    if(target == UINT64_MAX) {
+        throw std::out_of_range("No spiral value is bigger than the largest 64 bit number");
     }
 
-    return lookupCache.getAnswer();
+    SpiralStore store(target);
+    while(!store.hasReachedTarget()) {
+        store.addRing();
+    }
+    return store.getAnswer();
 }
 
-int main() {
-    auto steps = getNumberOfSteps(325489);
-    std::cout << steps << "\n";
+void solve(runner::Context& context) {
+    context.startPhase(runner::Phase::Part1);
+    auto steps = spiral::distance(325489);
+    context.out << steps << "\n";
 
+    context.startPhase(runner::Phase::Part2);
     auto answer = findNextLargestCumulativeValueWritten(325489);
-    std::cout << answer << "\n";
-    
-    return 0;
-}
\ No newline at end of file
+    context.out << answer << "\n";
+}
+}
+
+AOC_DAY("03", solve)
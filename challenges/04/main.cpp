@@ -1,24 +1,160 @@
 #include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <functional>
 #include <iostream>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 
-#include "algo.h"
+#include "cache.h"
 #include "input.h"
+#include "runner.h"
 
-std::string sortString(std::string s) {
-    std::sort(s.begin(), s.end());
-    return s;
+namespace {
+
+// what makes two words count as the same: the same letters in the same order, or just the same letters
+enum class Policy {
+    Exact, Anagram
+};
+
+// how many times each letter appears, four bits a letter packed into two words, so anagrams share a signature without sorting anything
+// words the counts can't describe, with something other than a-z or a letter more than 15 times, fall back to their sorted letters
+struct Signature {
+    std::array<uint64_t, 2> counts{};
+    std::string sorted;
+
+    constexpr bool operator==(const Signature&) const = default;
+};
+
+constexpr Signature getSignature(std::string_view word) {
+    Signature signature;
+    for(auto c: word) {
+        const auto letter = static_cast<unsigned>(c - 'a');
+        if(c < 'a' || c > 'z' || ((signature.counts[letter / 16] >> (letter % 16 * 4)) & 0xF) == 0xF) {
+            signature.counts = {};
+            signature.sorted = std::string(word);
+            std::sort(signature.sorted.begin(), signature.sorted.end());
+            return signature;
+        }
+        signature.counts[letter / 16] += uint64_t{1} << (letter % 16 * 4);
+    }
+    return signature;
+}
+
+static_assert(getSignature("listen") == getSignature("silent"));
+static_assert(getSignature("listen") != getSignature("listens"));
+static_assert(getSignature("b\"c") == getSignature("c\"b"));
+static_assert(getSignature("b\"c") != getSignature("bc"));
+static_assert(getSignature("Ab") != getSignature("ab"));
+static_assert(getSignature("aaaaaaaaaaaaaaaab") == getSignature("baaaaaaaaaaaaaaaa"));
+static_assert(getSignature("aaaaaaaaaaaaaaaab") != getSignature("aaaaaaaaaaaaaaab"));
+
+uint64_t hashKey(std::string_view word) {
+    return cache::hash(word);
 }
 
-bool isUnique(const std::string& passphrase) {
-    auto words = algo::map(input::split(passphrase), sortString);
-    std::sort(words.begin(), words.end());
-    return words.end() == std::unique(words.begin(), words.end());
+uint64_t hashKey(const Signature& signature) {
+    if(!signature.sorted.empty()) {
+        return cache::hash(signature.sorted);
+    }
+    return cache::hash(std::string_view(reinterpret_cast<const char*>(signature.counts.data()), sizeof(signature.counts)));
+}
+
+// open addressing set for the words of one passphrase at a time
+// starting a new passphrase bumps a generation number rather than clearing the slots, so the table is reused with no allocation
+template<typename Key>
+class WordSet {
+public:
+    // a passphrase of length n has at most (n + 1) / 2 words, and the table stays at most half full
+    void reset(size_t passphraseLength) {
+        const auto capacity = std::bit_ceil(passphraseLength + 2);
+        // slots left from 2^32 passphrases ago would look current once the generation wraps, so that clears them too
+        if(capacity > slots.size() || generation == UINT32_MAX) {
+            slots.assign(std::max(capacity, slots.size()), Slot{});
+            generation = 0u;
+        }
+        ++generation;
+    }
+
+    // false if the key was already in the set
+    bool insert(const Key& key) {
+        const auto hash = hashKey(key);
+        const auto mask = slots.size() - 1;
+        for(auto index = hash & mask; ; index = (index + 1) & mask) {
+            auto& slot = slots[index];
+            if(slot.generation != generation) {
+                slot = Slot{hash, key, generation};
+                return true;
+            }
+            if(slot.hash == hash && slot.key == key) {
+                return false;
+            }
+        }
+    }
+
+private:
+    struct Slot {
+        uint64_t hash = 0u;
+        Key key{};
+        uint32_t generation = 0u;
+    };
+
+    std::vector<Slot> slots;
+    uint32_t generation = 0u;
+};
+
+template<Policy policy>
+using KeyFor = std::conditional_t<policy == Policy::Exact, std::string_view, Signature>;
+
+template<Policy policy>
+bool isValid(std::string_view passphrase, WordSet<KeyFor<policy>>& words) {
+    words.reset(passphrase.size());
+    auto isWhitespace = [](char c) { return c == ' ' || c == '\t' || c == '\r'; };
+    auto start = 0u;
+    while(start < passphrase.size()) {
+        if(isWhitespace(passphrase[start])) {
+            ++start;
+            continue;
+        }
+        auto end = start;
+        while(end < passphrase.size() && !isWhitespace(passphrase[end])) {
+            ++end;
+        }
+        const auto word = passphrase.substr(start, end - start);
+        if constexpr(policy == Policy::Exact) {
+            if(!words.insert(word)) {
+                return false;
+            }
+        }
+        else {
+            if(!words.insert(getSignature(word))) {
+                return false;
+            }
+        }
+        start = end;
+    }
+    return true;
+}
+
+template<Policy policy>
+size_t countValid(std::string_view text) {
+    WordSet<KeyFor<policy>> words;
+    size_t count = 0u;
+    for(auto passphrase: input::splitLines(text)) {
+        count += isValid<policy>(passphrase, words);
+    }
+    return count;
+}
+
+void solve(runner::Context& context) {
+    context.startPhase(runner::Phase::Part1);
+    context.out << input::mapReduceLineBlocks("input/input04.txt", countValid<Policy::Exact>, size_t{0}, std::plus<>()) << "\n";
+    context.startPhase(runner::Phase::Part2);
+    context.out << input::mapReduceLineBlocks("input/input04.txt", countValid<Policy::Anagram>, size_t{0}, std::plus<>()) << "\n";
+}
 }
 
-int main() {
-    auto passPhrases = input::readMultiLineFile("input/input04.txt");
-    auto count = std::count_if(passPhrases.begin(), passPhrases.end(), isUnique);
-    std::cout << count << "\n";
-    return 0;
-}
\ No newline at end of file
+AOC_DAY("04", solve)
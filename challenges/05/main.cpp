@@ -1,8 +1,14 @@
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
+#include <limits>
 #include <string>
+#include <vector>
 
-#include "algo.h"
 #include "input.h"
+#include "runner.h"
+
+namespace {
 
 auto getStepsPart1(auto numbers) {
     auto index = 0u;
@@ -14,22 +20,130 @@ auto getStepsPart1(auto numbers) {
     return steps;
 }
 
-auto getStepsPart2(auto numbers) {
-    auto index = 0u;
-    auto steps = 0u;
-    while(index < numbers.size()) {
-        auto modifier = (numbers[index] >= 3)  ? -1 : 1;
-        auto old_index = index;
-        index += numbers[old_index];
-        numbers[old_index] += modifier;
-        steps++;
+// in part 2 every offset ends up flipping between 2 and 3, starting from the front of the maze,
+// and a run through cells that are all 2 or 3 always goes forwards and depends on nothing but where it started
+// so once 16 cells in a row have settled they are packed into a word (bit set for 3, clear for 2)
+// and the run through the word is looked up rather than stepped through
+using Packed = uint16_t;
+constexpr unsigned int PACKED_CELLS = 16;
+
+// a run coming out of one word lands 0, 1 or 2 cells into the next one, so there are three ways into a word,
+// and all three outcomes share one table entry: the lookup doesn't have to wait for the previous word's run to finish,
+// only picking out the right 20 bits does - the word afterwards, where the run leaves it, and the steps taken less 5
+constexpr unsigned int RUN_BITS = 20;
+constexpr unsigned int MIN_RUN_STEPS = 5;
+
+std::vector<uint64_t> makeRuns() {
+    std::vector<uint64_t> runs(size_t{1} << PACKED_CELLS, 0u);
+    for(auto before = 0u; before < runs.size(); ++before) {
+        for(auto entry = 0u; entry < 3u; ++entry) {
+            auto bits = before;
+            auto position = entry;
+            auto steps = 0u;
+            while(position < PACKED_CELLS) {
+                const auto isThree = (bits >> position) & 1u;
+                bits ^= 1u << position;
+                position += isThree ? 3 : 2;
+                ++steps;
+            }
+            const uint64_t run = bits | (position - PACKED_CELLS) << PACKED_CELLS | (steps - MIN_RUN_STEPS) << (PACKED_CELLS + 2);
+            runs[before] |= run << (entry * RUN_BITS);
+        }
+    }
+    return runs;
+}
+
+// the offsets are kept in the narrowest type that holds them, since part 2 never takes an offset outside
+// the range it started in (or past 3), and the settled front of the maze is packed 16 cells to a word
+template<typename Offset>
+uint64_t runPart2(const std::vector<int>& numbers) {
+    static const auto runs = makeRuns();
+    const auto size = static_cast<int64_t>(numbers.size());
+    std::vector<Offset> offsets(numbers.begin(), numbers.end());
+    std::vector<Packed> settled;
+
+    // the packed front grows a word at a time, once the next 16 cells past it have all settled
+    auto packSettledCells = [&]() {
+        for(auto first = static_cast<int64_t>(settled.size()) * PACKED_CELLS; first + PACKED_CELLS <= size; first += PACKED_CELLS) {
+            Packed bits = 0u;
+            for(auto i = 0u; i < PACKED_CELLS; ++i) {
+                const auto offset = offsets[first + i];
+                if(offset != 2 && offset != 3) {
+                    return;
+                }
+                bits |= (offset == 3) << i;
+            }
+            settled.push_back(bits);
+        }
+    };
+
+    int64_t index = 0;
+    uint64_t steps = 0u;
+    while(index >= 0 && index < size) {
+        const auto settledSize = static_cast<int64_t>(settled.size()) * PACKED_CELLS;
+        if(index < settledSize) {
+            // a jump back can land anywhere in a word, so that first word is stepped through a cell at a time
+            auto word = static_cast<size_t>(index / PACKED_CELLS);
+            auto position = static_cast<unsigned int>(index % PACKED_CELLS);
+            auto bits = settled[word];
+            for(; position < PACKED_CELLS; ++steps) {
+                const auto isThree = (bits >> position) & 1u;
+                bits ^= 1u << position;
+                position += isThree ? 3 : 2;
+            }
+            settled[word] = bits;
+            position -= PACKED_CELLS;
+
+            for(++word; word < settled.size(); ++word) {
+                const auto run = runs[settled[word]] >> (position * RUN_BITS);
+                settled[word] = static_cast<Packed>(run);
+                position = (run >> PACKED_CELLS) & 3u;
+                steps += MIN_RUN_STEPS + ((run >> (PACKED_CELLS + 2)) & 3u);
+            }
+            index = settledSize + position;
+            continue;
+        }
+
+        const auto offset = offsets[index];
+        offsets[index] += (offset >= 3) ? -1 : 1;
+        ++steps;
+        if(index < settledSize + PACKED_CELLS) {
+            packSettledCells();
+        }
+        index += offset;
     }
     return steps;
 }
 
-int main() {
-    auto numbers = algo::map(input::readMultiLineFile("input/input05.txt"), input::toNumber);
-    std::cout << getStepsPart1(numbers) << "\n";
-    std::cout << getStepsPart2(numbers) << "\n";
-    return 0;
-}
\ No newline at end of file
+template<typename Offset>
+bool fits(int min, int max) {
+    return min >= std::numeric_limits<Offset>::min() && max <= std::numeric_limits<Offset>::max();
+}
+
+uint64_t getStepsPart2(const std::vector<int>& numbers) {
+    if(numbers.empty()) {
+        return 0u;
+    }
+    const auto [min, max] = std::minmax_element(numbers.begin(), numbers.end());
+    // an offset below 3 can be pushed up as far as 3 before it settles
+    const auto largest = std::max(*max, 3);
+    if(fits<int8_t>(*min, largest)) {
+        return runPart2<int8_t>(numbers);
+    }
+    if(fits<int16_t>(*min, largest)) {
+        return runPart2<int16_t>(numbers);
+    }
+    return runPart2<int>(numbers);
+}
+
+void solve(runner::Context& context) {
+    std::vector<int> numbers;
+    input::parseNumbers(input::MappedFile("input/input05.txt").contents(), numbers);
+    context.startPhase(runner::Phase::Part1);
+    context.out << getStepsPart1(numbers) << "\n";
+    context.startPhase(runner::Phase::Part2);
+    context.out << getStepsPart2(numbers) << "\n";
+}
+}
+
+AOC_DAY("05", solve)
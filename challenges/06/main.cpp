@@ -1,38 +1,93 @@
 #include <algorithm>
-#include <assert.h>
+#include <cstdint>
 #include <iostream>
-#include <set>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
-#include "algo.h"
 #include "input.h"
+#include "runner.h"
 
-auto getNumberOfTimesBeforeSeeingDuplicates(const auto &input) {
-    auto numbers = input;
-    std::vector<decltype(numbers)> v;
-    
-    auto numberOfTimesThroughLoop = 0u;
-    while(std::find(v.begin(), v.end(), numbers) == v.end()) {
-        v.push_back(numbers);
-        auto max_element = std::max_element(numbers.begin(), numbers.end());
+namespace {
 
-        assert(max_element != numbers.end());
+using Banks = std::vector<uint32_t>;
 
-        const auto max_value = *max_element;
-        *max_element = 0;
-        algo::apply_cyclically(numbers, max_element+1, max_value, [](auto& s) { s += 1;});
+Banks toBanks(const std::vector<int>& numbers) {
+    if(numbers.empty()) {
+        throw std::invalid_argument("There are no memory banks");
+    }
+    if(std::any_of(numbers.begin(), numbers.end(), [](auto blocks) { return blocks < 0; })) {
+        throw std::invalid_argument("A bank can't hold a negative number of blocks");
+    }
+    // the total never changes, so if it fits every bank always fits
+    if(std::accumulate(numbers.begin(), numbers.end(), uint64_t{0}) > UINT32_MAX) {
+        throw std::out_of_range("Too many blocks to fit in a bank");
+    }
+    return Banks(numbers.begin(), numbers.end());
+}
+
+// the fullest bank (the first one on a tie) is emptied and every bank gets a full share of its blocks,
+// then the banks straight after it get one more each until the remainder runs out
+void redistribute(Banks& banks) {
+    const auto fullest = std::max_element(banks.begin(), banks.end());
+    const auto blocks = std::exchange(*fullest, 0u);
+    const auto share = static_cast<uint32_t>(blocks / banks.size());
+    auto remainder = blocks % banks.size();
+    if(share != 0u) {
+        for(auto& bank: banks) {
+            bank += share;
+        }
+    }
+    for(auto bank = std::next(fullest); remainder != 0u; ++bank, --remainder) {
+        if(bank == banks.end()) {
+            bank = banks.begin();
+        }
+        ++*bank;
+    }
+}
 
-        numberOfTimesThroughLoop++;
+// brent's cycle detection, so only a couple of configurations are ever held rather than every one seen so far
+// returns how many redistributions it takes to see a configuration for the second time, and how long the loop is
+auto getNumberOfTimesBeforeSeeingDuplicates(const Banks& start) {
+    // the hare runs ahead, and the tortoise jumps to it at every power of two, until the hare runs into it
+    uint64_t power = 1u;
+    uint64_t loopLength = 1u;
+    auto tortoise = start;
+    auto hare = start;
+    redistribute(hare);
+    while(tortoise != hare) {
+        if(power == loopLength) {
+            tortoise = hare;
+            power *= 2;
+            loopLength = 0u;
+        }
+        redistribute(hare);
+        ++loopLength;
     }
-    auto distance = std::distance(std::find(v.begin(), v.end(), numbers), v.end());
-    return std::make_pair(numberOfTimesThroughLoop, distance);
-    
+
+    // with the hare a whole loop ahead of the tortoise, they meet where the loop starts
+    tortoise = start;
+    hare = start;
+    for(uint64_t i = 0u; i < loopLength; ++i) {
+        redistribute(hare);
+    }
+    uint64_t loopStart = 0u;
+    while(tortoise != hare) {
+        redistribute(tortoise);
+        redistribute(hare);
+        ++loopStart;
+    }
+    return std::make_pair(loopStart + loopLength, loopLength);
+}
+
+void solve(runner::Context& context) {
+    const auto banks = toBanks(input::toNumbers(input::readSingleLineFile("input/input06.txt")));
+
+    context.startPhase(runner::Phase::Part1);
+    auto answer = getNumberOfTimesBeforeSeeingDuplicates(banks);
+    context.out << answer.first << " " << answer.second << "\n";
+}
 }
 
-int main() {
-    auto numbers = input::toNumbers(input::readSingleLineFile("input/input06.txt"));
-    
-    auto answer = getNumberOfTimesBeforeSeeingDuplicates(numbers);
-    std::cout << answer.first << " " << answer.second << "\n";
-    
-    return 0;
-}
\ No newline at end of file
+AOC_DAY("06", solve)
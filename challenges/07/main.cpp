@@ -7,10 +7,14 @@
 #include <map>
 #include <numeric>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "algo.h"
 #include "input.h"
+#include "runner.h"
+
+namespace {
 
 std::string stripFirstAndLastCharacter(const std::string &s) {
     return std::string(s.begin()+1, s.end()-1);
@@ -18,7 +22,7 @@ std::string stripFirstAndLastCharacter(const std::string &s) {
 
 
 struct InputTower {
-    explicit InputTower(const std::string &input) : totalWeight(std::nullopt) {
+    explicit InputTower(std::string_view input) : totalWeight(std::nullopt) {
         auto words = input::split(input);
         name = words[0];
 
@@ -78,6 +82,10 @@ std::string findImbalancedTower(const auto & towerLookup, const std::string& bas
     const auto &currentTower = towerLookup.at(baseTowerName);
     auto subTowers = algo::map(currentTower.subTowers, [&towerLookup](const std::string& s) { return towerLookup.at(s);});
 
+    // nothing above to be out of balance with, so the weight of this tower itself is wrong
+    if(subTowers.empty()) {
+        return currentTower.name;
+    }
     if(subTowers.size() == 1) {
         return findImbalancedTower(towerLookup, subTowers[0].name);
     }
@@ -108,16 +116,20 @@ auto findDifference(const auto &towerLookup, const std::string & imbalancedTower
     return towerLookup.at(imbalancedTower).weight + (differenceIter->getTotalWeight() - wrongWeight);
 }
 
-int main () {
-    auto towers = algo::map(input::readMultiLineFile("input/input07.txt"), [](const std::string& s){return InputTower(s);});
+void solve(runner::Context& context) {
+    const input::MappedFile file("input/input07.txt");
+    auto towers = input::parseLinesParallel(file.contents(), [](std::string_view s){return InputTower(s);});
     auto towerLookup = createTowerLookup(towers);
+    context.startPhase(runner::Phase::Part1);
     auto bottomTower = findBottomTowerName(towerLookup);
-    std::cout <<  bottomTower << "\n";
+    context.out <<  bottomTower << "\n";
 
+    context.startPhase(runner::Phase::Part2);
     populateTotalWeights(towerLookup, bottomTower);
     auto imbalancedTower = findImbalancedTower(towerLookup, bottomTower);
     auto difference = findDifference(towerLookup, imbalancedTower);
-    std::cout << imbalancedTower << " " << difference <<"\n";
-
-    return 0;
+    context.out << imbalancedTower << " " << difference <<"\n";
+}
 }
+
+AOC_DAY("07", solve)
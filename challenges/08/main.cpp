@@ -3,10 +3,13 @@
 #include <functional>
 #include <map>
 #include <string>
-#include <set>
+#include <string_view>
 
 #include "algo.h"
 #include "input.h"
+#include "runner.h"
+
+namespace {
 
 enum class Op {
     INC, DEC
@@ -14,19 +17,19 @@ enum class Op {
 
 struct Instruction {
 
-    explicit Instruction(const std::string & str) {
-        auto words = input::split(str);
+    explicit Instruction(std::string_view str) {
+        auto words = input::tokenize(str);
         assert(words.size() == 7);
 
         registerName = words[0];
         op = getOp(words[1]);
-        offset = std::stoi(words[2]);
+        offset = input::toNumber(words[2]);
 
         assert(words[3] == "if");
         targetRegister = words[4];
 
         using namespace std::placeholders;
-        condition = std::bind(getFunction(words[5]), _1, std::stoi(words[6]));
+        condition = std::bind(getFunction(words[5]), _1, input::toNumber(words[6]));
     }
 
     std::string registerName;
@@ -36,13 +39,13 @@ struct Instruction {
     std::function<bool(int)> condition;
 
 private:
-    Op getOp(const std::string& opString) {
+    Op getOp(std::string_view opString) {
         if (opString == "inc") return Op::INC;
         if (opString == "dec") return Op::DEC;
         throw std::runtime_error("Invalid operation");
     }
 
-    std::function<bool(int, int)> getFunction(const std::string& func) {
+    std::function<bool(int, int)> getFunction(std::string_view func) {
         if (func == ">") return std::greater<int>();
         if (func == ">=") return std::greater_equal<int>();
         if (func == "<") return std::less<int>();
@@ -61,35 +64,31 @@ int applyOperation(int value, const Instruction& instruction) {
     return value - instruction.offset;
 }
 
-Instruction toInstruction(const std::string & s) {
-    return Instruction(s);
+// registers start at zero the first time an instruction mentions them
+int& getRegister(std::map<std::string, int>& registerValues, const std::string& registerName) {
+    return registerValues.try_emplace(registerName, 0).first->second;
 }
 
-auto populateRegisters(const auto& instructions) {
-    std::set<std::string> registers;
-    
-    std::transform(instructions.begin(), instructions.end(), std::inserter(registers, registers.begin()), [](const Instruction& i) { return i.registerName; });
-    std::transform(instructions.begin(), instructions.end(), std::inserter(registers, registers.begin()), [](const Instruction& i) { return i.targetRegister; });
-
+void solve(runner::Context& context) {
+    // instructions run in file order and are never revisited, so they can be executed as they are read
+    // both parts are worked out as the instructions are read, so it is all timed as part 1
+    context.startPhase(runner::Phase::Part1);
     std::map<std::string, int> registerValues;
-    std::transform(registers.begin(), registers.end(), std::inserter(registerValues, registerValues.begin()), [](const std::string & registerName) { return make_pair(registerName, 0);});
-    return registerValues;
-}
-
-int main() { 
-    const auto instructions = algo::map(input::readMultiLineFile("input/input08.txt"), toInstruction);
-    auto registerValues = populateRegisters(instructions);
-    
     auto highestValueSeen = 0;
-    std::for_each(instructions.begin(), instructions.end(), [&registerValues, &highestValueSeen](const Instruction &i){
-        if(i.condition(registerValues.at(i.targetRegister))) {
-            registerValues[i.registerName] = applyOperation(registerValues.at(i.registerName), i);
-            highestValueSeen = std::max(highestValueSeen, registerValues[i.registerName]);
+    for(auto line: input::LineStream("input/input08.txt")) {
+        const Instruction i(line);
+        const auto targetValue = getRegister(registerValues, i.targetRegister);
+        auto& value = getRegister(registerValues, i.registerName);
+        if(i.condition(targetValue)) {
+            value = applyOperation(value, i);
+            highestValueSeen = std::max(highestValueSeen, value);
         }
-    });
+    }
 
     const auto max = std::max_element(registerValues.begin(), registerValues.end(), [](auto regPair1, auto regPair2) { return regPair1.second < regPair2.second;});
-    std::cout << max->second << " " << max->first << "\n";
-    std::cout << highestValueSeen << "\n";
-    return 0;
-}
\ No newline at end of file
+    context.out << max->second << " " << max->first << "\n";
+    context.out << highestValueSeen << "\n";
+}
+}
+
+AOC_DAY("08", solve)
@@ -4,6 +4,9 @@
 #include <utility>
 
 #include "input.h"
+#include "runner.h"
+
+namespace {
 
 std::string discardIgnoredCharacters(const std::string & s) {
     std::string returnValue;
@@ -58,9 +61,12 @@ unsigned int getScore(const std::string & s) {
     return score;
 }
 
-int main() {
+void solve(runner::Context& context) {
     std::string input = input::readSingleLineFile("input/input09.txt");
+    context.startPhase(runner::Phase::Part1);
     auto prunedData = removeGarbage(discardIgnoredCharacters(input));
-    std::cout << getScore(prunedData.first) << " " << prunedData.second <<  "\n";
-    return 0;
-}
\ No newline at end of file
+    context.out << getScore(prunedData.first) << " " << prunedData.second <<  "\n";
+}
+}
+
+AOC_DAY("09", solve)
@@ -1,23 +1,30 @@
 #include <algorithm>
 #include <iostream>
 #include <iterator>
+#include <vector>
 
 #include "algo.h"
 #include "crypto.h"
 #include "input.h"
+#include "runner.h"
 
+namespace {
 
-int main() {
+void solve(runner::Context& context) {
     auto input = input::readSingleLineFile("input/input10.txt");
-    auto lineLengths = algo::map(input::split(input, ','), input::toNumber);
-    auto &cb = *crypto::createHashedCircularBuffer(lineLengths);
-    std::cout << cb[0] * cb[1] << "\n";
+    std::vector<int> lineLengths;
+    input::parseNumbers(input, ',', lineLengths);
+    context.startPhase(runner::Phase::Part1);
+    auto cb = crypto::createHashedCircularBuffer(lineLengths);
+    context.out << (*cb)[0] * (*cb)[1] << "\n";
 
-    auto denseHash = crypto::calculateDenseHash(input);
+    context.startPhase(runner::Phase::Part2);
+    auto denseHash = crypto::knotHash(input);
 
-    std::cout << std::hex;
-    std::copy(denseHash.begin(), denseHash.end(), std::ostream_iterator<int>(std::cout));
-    std::cout << "\n";
-
-    return 0;
+    context.out << std::hex;
+    std::copy(denseHash.begin(), denseHash.end(), std::ostream_iterator<int>(context.out));
+    context.out << "\n";
+}
 }
+
+AOC_DAY("10", solve)
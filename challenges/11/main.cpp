@@ -1,15 +1,19 @@
 #include <iostream>
 #include <map>
+#include <algorithm>
 #include <numeric>
+#include <string_view>
 
 #include "algo.h"
 #include "input.h"
+#include "runner.h"
 
+namespace {
 
 using Coordinate = std::pair<int,int>;
 
-auto toCoordinate(const std::string &direction) {
-    std::map<std::string, Coordinate> m  = {
+auto toCoordinate(std::string_view direction) {
+    static const std::map<std::string_view, Coordinate> m  = {
         {"n", {0,10}},
         {"ne", {5,5}},
         {"se", {5,-5}},
@@ -52,19 +56,20 @@ auto findShortestPath(const Coordinate& childLocation) {
 auto moveChild(const auto& directions) {
     std::vector<Coordinate> path = {Coordinate{0,0}};
     auto childPath = std::accumulate(directions.begin(), directions.end(), path, addCoordinates);
-    auto shortestPaths = algo::map(childPath, findShortestPath);
-    auto furthestAway = std::max_element(shortestPaths.begin(), shortestPaths.end());
-    return std::make_pair(*shortestPaths.rbegin(), *furthestAway);
+    auto shortestPaths = algo::lazy::map(childPath, findShortestPath);
+    return std::make_pair(findShortestPath(*childPath.rbegin()), std::ranges::max(shortestPaths));
 }
 
-int main() {
+void solve(runner::Context& context) {
 
-    auto input = input::split(input::readSingleLineFile("input/input11.txt"), ',');
-    auto directions = algo::map(input, toCoordinate);
+    const input::MappedFile file("input/input11.txt");
+    auto directions = algo::map(input::tokenize(file.firstLine(), ','), toCoordinate);
 
+    context.startPhase(runner::Phase::Part1);
     auto shortestPath = moveChild(directions);
 
-    std::cout << shortestPath.first << " " << shortestPath.second << "\n";
+    context.out << shortestPath.first << " " << shortestPath.second << "\n";
+}
+}
 
-    return 0;
-}
\ No newline at end of file
+AOC_DAY("11", solve)
@@ -3,41 +3,55 @@
 #include <deque>
 #include <iostream>
 #include <map>
+#include <memory_resource>
 #include <set>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "algo.h"
+#include "arena.h"
 #include "input.h"
+#include "runner.h"
 
-auto toPipeInformation(const std::string& input) {
-    auto words = input::split(input);
-    assert(words[1] == "<->");
+namespace {
 
-    std::vector<std::string> connections(words.begin()+2, words.end());
-    return std::make_pair(words[0], algo::map(connections, input::dropTrailingComma));
+// all of the run's maps, sets and queues live in one arena, and the names are pmr strings so they do too
+using Connections = std::pmr::map<std::pmr::string, std::pmr::vector<std::pmr::string>>;
+
+// the names are copied out of the mapped file straight into the arena
+void addPipe(Connections& connections, std::string_view pipe) {
+    const auto words = input::tokenize(pipe);
+    assert(words.size() >= 2 && words[1] == "<->");
+
+    auto& connectedNodes = connections.try_emplace(std::pmr::string(words[0], connections.get_allocator())).first->second;
+    for(auto word = words.begin()+2; word != words.end(); ++word) {
+        connectedNodes.emplace_back(word->ends_with(',') ? word->substr(0, word->size() - 1) : *word);
+    }
 }
 
-auto getNodesConnected(const auto& connections, const std::string& start) {
-    std::set<std::string> nodesSeen;
-    std::deque<std::string> nodesToCheck;
-    nodesToCheck.push_front(start);
+auto getNodesConnected(const Connections& connections, std::string_view start, std::pmr::memory_resource* resource) {
+    std::pmr::set<std::pmr::string> nodesSeen(resource);
+    std::pmr::deque<std::pmr::string> nodesToCheck(resource);
+    nodesToCheck.emplace_front(start);
 
     while(!nodesToCheck.empty()) {
-        const auto& node = nodesToCheck.front();
+        auto node = std::move(nodesToCheck.front());
         nodesToCheck.pop_front();
         if(nodesSeen.find(node) == nodesSeen.end()) {
             const auto& nextConnections = connections.at(node);
             std::copy(nextConnections.begin(), nextConnections.end(), std::back_inserter(nodesToCheck));
         }
-        nodesSeen.insert(node);
+        nodesSeen.insert(std::move(node));
     }
     return nodesSeen;
 }
 
-auto getGroups(auto connections) {
+auto getGroups(const Connections& allConnections, std::pmr::memory_resource* resource) {
+    Connections connections(allConnections, resource);
     auto numberOfGroups = 0u;
     while(!connections.empty()) {
-        auto group = getNodesConnected(connections, connections.begin()->first);
+        auto group = getNodesConnected(connections, connections.begin()->first, resource);
         ++numberOfGroups;
         auto alreadySeen = [&group](const auto& connection) { return group.find(connection.first) != group.end(); };
         algo::erase_if(connections, alreadySeen);
@@ -45,10 +59,19 @@ auto getGroups(auto connections) {
     return numberOfGroups;
 }
 
-int main() {
-    auto pipes = input::readMultiLineFile("input/input12.txt");
-    std::map<std::string, std::vector<std::string>> connections;
-    std::transform(pipes.begin(), pipes.end(), std::inserter(connections, connections.begin()), toPipeInformation);
-    std::cout << getNodesConnected(connections, "0").size() << " " << getGroups(connections) << "\n";
-    return 0;
+void solve(runner::Context& context) {
+    arena::Arena arena;
+    const input::MappedFile file("input/input12.txt");
+    Connections connections(arena.resource());
+    for(auto pipe: file.lines()) {
+        addPipe(connections, pipe);
+    }
+    context.startPhase(runner::Phase::Part1);
+    auto nodesConnected = getNodesConnected(connections, "0", arena.resource()).size();
+    context.startPhase(runner::Phase::Part2);
+    auto groups = getGroups(connections, arena.resource());
+    context.out << nodesConnected << " " << groups << "\n";
+}
 }
+
+AOC_DAY("12", solve)
@@ -6,6 +6,9 @@
 
 #include "algo.h"
 #include "input.h"
+#include "runner.h"
+
+namespace {
 
 class Layer {
 public:
@@ -57,7 +60,7 @@ Layer toLayer(const std::string & str) {
     return Layer{stoi(depth), stoi(range)};
 }
 
-std::ostream& operator<<(std::ostream& os, const Layer& layer) {
+[[maybe_unused]] std::ostream& operator<<(std::ostream& os, const Layer& layer) {
     os << std::to_string(layer.depth) << " " << std::to_string(layer.range);
     return os;
 }
@@ -87,10 +90,14 @@ int getDelay(const auto& layers) {
 }
 
 
-int main() {
+void solve(runner::Context& context) {
     auto layers = algo::map(input::readMultiLineFile("input/input13.txt"), toLayer);
+    context.startPhase(runner::Phase::Part1);
     auto severity = getSeverityOfViolations(layers);
+    context.startPhase(runner::Phase::Part2);
     auto delay = getDelay(layers);
-    std::cout << severity << " " << delay << "\n";
-    return 0;
-}
\ No newline at end of file
+    context.out << severity << " " << delay << "\n";
+}
+}
+
+AOC_DAY("13", solve)
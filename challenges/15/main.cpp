@@ -1,5 +1,9 @@
 #include <iostream>
 
+#include "runner.h"
+
+namespace {
+
 constexpr unsigned int GENERATOR_A_FACTOR = 16807;
 constexpr unsigned int GENERATOR_B_FACTOR = 48271;
 
@@ -22,13 +26,17 @@ unsigned int get_matching_pairs(unsigned int factorA, unsigned int factorB, unsi
     return count;
 }
 
-int main(){
-    std::cout << "Matching pairs in first 40 million: "
-              << get_matching_pairs(GENERATOR_A_FACTOR, GENERATOR_B_FACTOR, 40'000'000)
-              << "\n";
-    std::cout << "Matching pairs in first 5 million (more aligned): "
-              << get_matching_pairs(GENERATOR_A_FACTOR, GENERATOR_B_FACTOR, 5'000'000,
-                                    0x3, 0x7) // mask 2 bits or three bits respectively
-              << "\n";
-    return 0;
+void solve(runner::Context& context) {
+    context.startPhase(runner::Phase::Part1);
+    context.out << "Matching pairs in first 40 million: "
+                << get_matching_pairs(GENERATOR_A_FACTOR, GENERATOR_B_FACTOR, 40'000'000)
+                << "\n";
+    context.startPhase(runner::Phase::Part2);
+    context.out << "Matching pairs in first 5 million (more aligned): "
+                << get_matching_pairs(GENERATOR_A_FACTOR, GENERATOR_B_FACTOR, 5'000'000,
+                                      0x3, 0x7) // mask 2 bits or three bits respectively
+                << "\n";
 }
+}
+
+AOC_DAY("15", solve)
@@ -1,11 +1,15 @@
 #include <algorithm>
 #include <iostream>
 #include <numeric>
+#include <string_view>
 #include <variant>
 #include <vector>
 #include <unordered_map>
 
 #include "input.h"
+#include "runner.h"
+
+namespace {
 
 struct Spin {
     unsigned long int times;
@@ -24,19 +28,19 @@ using Steps = std::vector<Step>;
 
 template<class... Ts> struct overloaded : Ts... { using Ts::operator()...; };
 
-Exchange make_exchange(const std::string & text) {
-    const auto positions = input::split(std::string(text.begin()+1, text.end()), '/');
-    return Exchange{std::stoul(positions[0]),std::stoul(positions[1])};
+Exchange make_exchange(std::string_view text) {
+    const auto positions = input::tokenize(text.substr(1), '/');
+    return Exchange{static_cast<unsigned long>(input::toNumber(positions[0])), static_cast<unsigned long>(input::toNumber(positions[1]))};
 }
 
 Steps get_dance_steps(const std::string & filename) {
-    const auto text = input::readSingleLineFile(filename);
-    const auto textSteps = input::split(text, ',');
+    const input::MappedFile file(filename);
+    const auto textSteps = input::tokenize(file.firstLine(), ',');
     Steps outVector;
     std::transform(textSteps.begin(), textSteps.end(), std::back_inserter(outVector), [](const auto& s) -> Step {
         switch (s[0]) {
             case 's':
-                return Spin{std::stoul(std::string(s.begin()+1, s.end()))};
+                return Spin{static_cast<unsigned long>(input::toNumber(s.substr(1)))};
             case 'x':
                 return make_exchange(s);
             case 'p':
@@ -87,8 +91,13 @@ std::string lots_of_dancing(std::string programs, const Steps& steps, unsigned i
 
 
 std::string programs = "abcdefghijklmnop";
-int main() {
+void solve(runner::Context& context) {
    const Steps steps = get_dance_steps("input/input16.txt");
-   std::cout << "Order after dance: " << dance(programs, steps) << "\n";
-   std::cout << "Order after lots of dance: " << lots_of_dancing(programs, steps, 1'000'000) << "\n";
+   context.startPhase(runner::Phase::Part1);
+   context.out << "Order after dance: " << dance(programs, steps) << "\n";
+   context.startPhase(runner::Phase::Part2);
+   context.out << "Order after lots of dance: " << lots_of_dancing(programs, steps, 1'000'000) << "\n";
+}
 }
+
+AOC_DAY("16", solve)
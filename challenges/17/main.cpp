@@ -1,6 +1,10 @@
 #include <iostream>
 #include <vector>
 
+#include "runner.h"
+
+namespace {
+
 constexpr size_t SPINS = 328;
 
 class SpinlockAlgorithm{
@@ -75,8 +79,12 @@ unsigned int get_angry_spinlock_value() {
     return spinlock.getNumberAfterZero();
 }
 
-int main() {
-    std::cout << "Value after 2017: " <<  get_value_after_2017() << "\n";
-    std::cout << "Value after 50,000,000: " <<  get_angry_spinlock_value() << "\n";
-    return 0;
+void solve(runner::Context& context) {
+    context.startPhase(runner::Phase::Part1);
+    context.out << "Value after 2017: " <<  get_value_after_2017() << "\n";
+    context.startPhase(runner::Phase::Part2);
+    context.out << "Value after 50,000,000: " <<  get_angry_spinlock_value() << "\n";
 }
+}
+
+AOC_DAY("17", solve)
@@ -6,6 +6,10 @@
 
 #include "algo.h"
 #include "input.h"
+#include "instrument.h"
+#include "runner.h"
+
+namespace {
 
 struct UnaryInstruction {
     char registerName;
@@ -49,6 +53,7 @@ public:
 protected:
 
     void runSingleInstruction() {
+        AOC_COUNT("day 18 instructions executed", 1);
         const auto& instruction = instructions[instructionPointer];
         std::visit( overloaded {
             [this](Snd snd){this->snd(snd);},
@@ -226,12 +231,14 @@ void pair(MessagingComputer& lhs, MessagingComputer& rhs){
     rhs.partner = &lhs;
 }
 
-int main() {
+void solve(runner::Context& context) {
     const auto instructions = algo::map(input::readMultiLineFile("input/input18.txt"), to_instruction);
+    context.startPhase(runner::Phase::Part1);
     SoundComputer computer(instructions);
     computer.runUntilRcv();
-    std::cout << computer.getLastRecoveredSound() << "\n";
+    context.out << computer.getLastRecoveredSound() << "\n";
 
+    context.startPhase(runner::Phase::Part2);
     MessagingComputer computer0(0,instructions);
     MessagingComputer computer1(1,instructions);
     pair(computer0, computer1);
@@ -241,5 +248,8 @@ int main() {
         computer1.runSingleInstruction();
     }
 
-    std::cout << "Times sent: " << computer1.get_number_of_values_sent() << "\n";
+    context.out << "Times sent: " << computer1.get_number_of_values_sent() << "\n";
+}
 }
+
+AOC_DAY("18", solve)
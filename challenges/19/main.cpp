@@ -3,6 +3,10 @@
 
 #include <input.h>
 
+#include "runner.h"
+
+namespace {
+
 struct Point {
     size_t x = 0;
     size_t y = 0;
@@ -92,7 +96,7 @@ public:
         Point pos = start;
         Direction dir = Direction::DOWN;
         while (pos != end){
-            Intersection next;
+            Intersection next{};
             std::vector<Intersection> intersectionsInArea;
             switch (dir){
                 case Direction::DOWN:
@@ -139,10 +143,13 @@ private:
     Point end;
 };
 
-int main() {
+void solve(runner::Context& context) {
     Diagram diagram(input::readMultiLineFile("input/input19.txt"));
+    context.startPhase(runner::Phase::Part1);
     auto [string, steps] = diagram.getString();
-    std::cout << "String of route: " << string << "\n";
-    std::cout << "# of steps: " << steps << "\n";
-
+    context.out << "String of route: " << string << "\n";
+    context.out << "# of steps: " << steps << "\n";
 }
+}
+
+AOC_DAY("19", solve)
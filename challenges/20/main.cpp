@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
 #include <compare>
@@ -8,9 +9,14 @@
 #include <regex>
 #include <span>
 #include <set>
+#include <string_view>
 
 #include "algo.h"
+#include "cache.h"
 #include "input.h"
+#include "runner.h"
+
+namespace {
 
 int sign(int64_t n1) {
     return n1 >= 0 ? 1 : -1;
@@ -56,9 +62,13 @@ std::optional<int> getLargestQuadraticSolution(int64_t acc1, int64_t acc2, int64
 
 }
 
+// position, velocity and acceleration as they appear in the input
+using ParticleValues = std::array<int, 9>;
+
 class Particle {
 public:
     Particle(unsigned int id, int posx, int posy, int posz, int velx, int vely, int velz, int accx, int accy, int accz) : id(id), pos{posx, posy, posz}, startingPos{pos}, vel{velx, vely, velz}, startingVel{vel}, acc{accx, accy, accz}  {}
+    Particle(unsigned int id, const ParticleValues& v) : Particle(id, v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7], v[8]) {}
 
     unsigned int getManhattanDistance() const {
         return pos.getManhattanDistance();
@@ -121,14 +131,12 @@ private:
     uint64_t time = 0;
 };
 
-Particle toParticle(const std::string& text) {
-    static unsigned int counter = 0;
-    std::regex particleRegex { "p=<(-?\\d+),(-?\\d+),(-?\\d+)>, v=<(-?\\d+),(-?\\d+),(-?\\d+)>, a=<(-?\\d+),(-?\\d+),(-?\\d+)>" };
-    std::smatch match;
+ParticleValues parseParticle(std::string_view text) {
+    static const std::regex particleRegex { "p=<(-?\\d+),(-?\\d+),(-?\\d+)>, v=<(-?\\d+),(-?\\d+),(-?\\d+)>, a=<(-?\\d+),(-?\\d+),(-?\\d+)>" };
+    std::match_results<std::string_view::const_iterator> match;
 
-    if(std::regex_search(text, match, particleRegex)){
-        return Particle {
-            counter++,
+    if(std::regex_search(text.begin(), text.end(), match, particleRegex)){
+        return ParticleValues {
             std::stoi(match[1]),
             std::stoi(match[2]),
             std::stoi(match[3]),
@@ -142,7 +150,17 @@ Particle toParticle(const std::string& text) {
     }
 
     assert(false);
-    return Particle{0,0,0,0,0,0,0,0,0,0};
+    return ParticleValues{};
+}
+
+// ids are line numbers, so they are handed out once parsing is done rather than while lines are parsed in parallel
+std::vector<Particle> toParticles(std::span<const ParticleValues> values) {
+    std::vector<Particle> particles;
+    particles.reserve(values.size());
+    for(const auto& v: values) {
+        particles.emplace_back(particles.size(), v);
+    }
+    return particles;
 }
 
 std::pair<bool, uint64_t> willBeCloserToOrigin(const Particle& particle1, const Particle& particle2) {
@@ -192,13 +210,19 @@ size_t getNumberOfNonCollidingParticles(std::span<Particle> particles, uint64_t
 
 }
 
-int main() { 
-    auto particles = algo::map(input::readMultiLineFile("input/input20.txt"), toParticle);
+void solve(runner::Context& context) {
+    const auto particleValues = cache::loadOrBuild<ParticleValues>("input/input20.txt", 1u, [](std::string_view contents) {
+        return input::parseLinesParallel(contents, parseParticle);
+    });
+    auto particles = toParticles(particleValues.values());
+    context.startPhase(runner::Phase::Part1);
     runUntilMovingAwayFromOrigin(particles);
     auto [particle, time] = getClosestToOrigin(particles);
-    std::cout << particle << "\n";
+    context.out << particle << "\n";
 
-    std::cout << "Non-colliding particles: " << getNumberOfNonCollidingParticles(particles, time) << "\n";
+    context.startPhase(runner::Phase::Part2);
+    context.out << "Non-colliding particles: " << getNumberOfNonCollidingParticles(particles, time) << "\n";
+}
+}
 
-    return 0;
-}
\ No newline at end of file
+AOC_DAY("20", solve)
@@ -1,5 +1,8 @@
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
+#include <cstdint>
 #include <iostream>
 #include <map>
 #include <numeric>
@@ -10,9 +13,13 @@
 
 #include "input.h"
 #include "algo.h"
+#include "cache.h"
+#include "runner.h"
+
+namespace {
 using Rule = std::pair<std::string, std::string>;
 
-Rule toRule(const std::string& text) {
+Rule toRule(std::string_view text) {
     auto parts = input::split(text, ' ');
     assert(parts.size() == 3);
     return {parts[0], parts[2]};
@@ -65,19 +72,68 @@ std::string flip(const std::string& text) {
 
 using RulesMapping = std::map<std::string, Blocks>;
 
-RulesMapping createRuleMapping(std::span<Rule> rules){
+// a rule with its pattern already turned to one of its eight orientations
+// it is fixed size so the expanded rules can be kept in the input cache
+struct ExpandedRule {
+    std::array<char, 11> pattern;
+    std::array<char, 19> enhancement;
+    uint8_t patternLength;
+    uint8_t enhancementLength;
+
+    std::string getPattern() const {
+        return std::string(pattern.data(), patternLength);
+    }
+
+    std::string getEnhancement() const {
+        return std::string(enhancement.data(), enhancementLength);
+    }
+};
+
+ExpandedRule toExpandedRule(const std::string& pattern, const std::string& enhancement) {
+    ExpandedRule rule{};
+    assert(pattern.size() <= rule.pattern.size() && enhancement.size() <= rule.enhancement.size());
+    std::ranges::copy(pattern, rule.pattern.begin());
+    std::ranges::copy(enhancement, rule.enhancement.begin());
+    rule.patternLength = pattern.size();
+    rule.enhancementLength = enhancement.size();
+    return rule;
+}
+
+// the eight orientations of each rule are kept next to each other, so they can share one split enhancement
+constexpr size_t ORIENTATIONS = 8;
+
+std::array<ExpandedRule, ORIENTATIONS> expandRule(const Rule& rule) {
+    return {
+        toExpandedRule(rule.first, rule.second),
+        toExpandedRule(transpose(rule.first), rule.second),
+        toExpandedRule(transpose(transpose(rule.first)), rule.second),
+        toExpandedRule(transpose(transpose(transpose(rule.first))), rule.second),
+        toExpandedRule(flip(rule.first), rule.second),
+        toExpandedRule(transpose(flip(rule.first)), rule.second),
+        toExpandedRule(transpose(transpose(flip(rule.first))), rule.second),
+        toExpandedRule(transpose(transpose(transpose(flip(rule.first)))), rule.second)
+    };
+}
+
+std::vector<ExpandedRule> expandRules(std::span<const Rule> rules){
+    const auto expanded = algo::map(algo::parallel, rules, expandRule);
+    std::vector<ExpandedRule> out;
+    out.reserve(rules.size() * ORIENTATIONS);
+    for(const auto& orientations: expanded) {
+        out.insert(out.end(), orientations.begin(), orientations.end());
+    }
+    return out;
+}
+
+RulesMapping createRuleMapping(std::span<const ExpandedRule> rules){
     RulesMapping out;
 
-    for(const auto& rule: rules) {
-        auto blocks = getBlocks(rule.second);
-        out[rule.first] = blocks;
-        out[transpose(rule.first)] = blocks;
-        out[transpose(transpose(rule.first))] = blocks;
-        out[transpose(transpose(transpose(rule.first)))] = blocks;
-        out[flip(rule.first)] = blocks;
-        out[transpose(flip(rule.first))] = blocks;
-        out[transpose(transpose(flip(rule.first)))] = blocks;
-        out[transpose(transpose(transpose(flip(rule.first))))] = blocks;
+    assert(rules.size() % ORIENTATIONS == 0);
+    for(size_t first = 0; first < rules.size(); first += ORIENTATIONS) {
+        const auto blocks = getBlocks(rules[first].getEnhancement());
+        for(const auto& rule: rules.subspan(first, ORIENTATIONS)) {
+            out[rule.getPattern()] = blocks;
+        }
     }
 
     return out;
@@ -174,13 +230,19 @@ unsigned int getLightsOn(const Blocks& blocks){
     });
 }
 
-int main() { 
+void solve(runner::Context& context) {
     Blocks startingPattern {".#./..#/###"};
-    auto rules = algo::map(input::readMultiLineFile("input/input21.txt"), toRule);
-    auto ruleMapping = createRuleMapping(rules);
+    const auto expandedRules = cache::loadOrBuild<ExpandedRule>("input/input21.txt", 1u, [](std::string_view contents) {
+        return expandRules(input::parseLinesParallel(contents, toRule));
+    });
+    auto ruleMapping = createRuleMapping(expandedRules.values());
+    context.startPhase(runner::Phase::Part1);
     auto blocks = iterate(startingPattern, ruleMapping, 5U);
-    std::cout << getLightsOn(blocks) << "\n";
+    context.out << getLightsOn(blocks) << "\n";
+    context.startPhase(runner::Phase::Part2);
     auto blocks18 = iterate(startingPattern, ruleMapping, 18U);
-    std::cout << getLightsOn(blocks18) << "\n";
-    return 0;
-}
\ No newline at end of file
+    context.out << getLightsOn(blocks18) << "\n";
+}
+}
+
+AOC_DAY("21", solve)
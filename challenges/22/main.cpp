@@ -1,9 +1,15 @@
 #include <compare>
 #include <iostream>
+#include <memory_resource>
 #include <set>
 #include <span>
 
+#include "arena.h"
 #include "input.h"
+#include "instrument.h"
+#include "runner.h"
+
+namespace {
 
 enum class Direction {
     Up,
@@ -60,8 +66,9 @@ Coord move(const Coord& coord, Direction dir) {
     }
 }
 
-auto getInfected(std::span<std::string> grid) {
-    std::set<Coord> infected;
+// the sets are inserted into and erased from on nearly every burst, so their nodes come from an arena that recycles them
+auto getInfected(std::span<std::string> grid, std::pmr::memory_resource* resource) {
+    std::pmr::set<Coord> infected(resource);
 
     for(size_t rowIndex=0; rowIndex < grid.size(); ++rowIndex){
         for(size_t columnIndex=0; columnIndex < grid[rowIndex].size(); ++columnIndex){
@@ -74,11 +81,12 @@ auto getInfected(std::span<std::string> grid) {
 
 }
 
-size_t getActiveBursts(std::span<std::string> grid, unsigned int numberOfMoves){
+size_t getActiveBursts(std::span<std::string> grid, unsigned int numberOfMoves, std::pmr::memory_resource* resource){
+    AOC_SCOPE("day 22 bursts");
     int midy = grid.size() / 2;
     int midx = grid[midy].length() / 2;
 
-    std::set<Coord> infected = getInfected(grid);
+    std::pmr::set<Coord> infected = getInfected(grid, resource);
 
     Direction virusDirection = Direction::Up;
     Coord virusPosition {midx, midy};
@@ -101,13 +109,14 @@ size_t getActiveBursts(std::span<std::string> grid, unsigned int numberOfMoves){
 
 }
 
-size_t getAdvancedNumberOfBursts(std::span<std::string> grid, unsigned int numberOfMoves){
+size_t getAdvancedNumberOfBursts(std::span<std::string> grid, unsigned int numberOfMoves, std::pmr::memory_resource* resource){
+    AOC_SCOPE("day 22 advanced bursts");
     int midy = grid.size() / 2;
     int midx = grid[midy].length() / 2;
 
-    std::set<Coord> infected = getInfected(grid);
-    std::set<Coord> weakened;
-    std::set<Coord> flagged;
+    std::pmr::set<Coord> infected = getInfected(grid, resource);
+    std::pmr::set<Coord> weakened(resource);
+    std::pmr::set<Coord> flagged(resource);
 
     Direction virusDirection = Direction::Up;
     Coord virusPosition {midx, midy};
@@ -145,8 +154,14 @@ size_t getAdvancedNumberOfBursts(std::span<std::string> grid, unsigned int numbe
      
 }
 
-int main() {
+void solve(runner::Context& context) {
+    arena::Arena arena;
     auto grid = input::readMultiLineFile("input/input22.txt");
-    std::cout << "Active bursts: " << getActiveBursts(grid, 10'000) << "\n";
-    std::cout << "Active bursts: " << getAdvancedNumberOfBursts(grid, 10'000'000) << "\n";
-}
\ No newline at end of file
+    context.startPhase(runner::Phase::Part1);
+    context.out << "Active bursts: " << getActiveBursts(grid, 10'000, arena.resource()) << "\n";
+    context.startPhase(runner::Phase::Part2);
+    context.out << "Active bursts: " << getAdvancedNumberOfBursts(grid, 10'000'000, arena.resource()) << "\n";
+}
+}
+
+AOC_DAY("22", solve)
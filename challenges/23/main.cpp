@@ -6,6 +6,9 @@
 
 #include "algo.h"
 #include "input.h"
+#include "runner.h"
+
+namespace {
 
 struct Instruction {
     std::string operation;
@@ -13,7 +16,7 @@ struct Instruction {
     std::string arg2;
 };
 
-Instruction toInstruction(const std::string& str) { 
+[[maybe_unused]] Instruction toInstruction(const std::string& str) { 
     auto text = input::split(str, ' ');
     assert(text.size() == 3);
     return {text[0], text[1], text[2]};
@@ -89,21 +92,23 @@ bool isComposite(unsigned int b) {
     return false;
 }
 
-int main() {
-
-    //part 2
+void solve(runner::Context& context) {
+    // only part 2 is solved, running part 1 for real is left commented out below
+    context.startPhase(runner::Phase::Part2);
     unsigned int numberOfTimesHIsHit = 0;
     for(unsigned int b = 109900; b <= 126900; b+=17){
         if(isComposite(b)){
             numberOfTimesHIsHit++;
         }
     }
-    std::cout << " Number of h's hit: " << numberOfTimesHIsHit << "\n";
+    context.out << " Number of h's hit: " << numberOfTimesHIsHit << "\n";
 
     // don't run the following unless you want to wait a very long time
     // auto instructions = algo::map(input::readMultiLineFile("input/input23.txt"), toInstruction);
     // Computer computer{instructions};
     // computer.run();
-    // std::cout << "Multiplications hit: " << computer.getMultiplicationsInvoked() << "\n";
-    return 0;
-}
\ No newline at end of file
+    // context.out << "Multiplications hit: " << computer.getMultiplicationsInvoked() << "\n";
+}
+}
+
+AOC_DAY("23", solve)
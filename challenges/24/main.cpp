@@ -1,5 +1,6 @@
 #include <algorithm>
 #include <iostream>
+#include <memory_resource>
 #include <queue>
 #include <ranges>
 #include <span>
@@ -8,7 +9,12 @@
 #include <vector>
 
 #include "algo.h"
+#include "arena.h"
 #include "input.h"
+#include "instrument.h"
+#include "runner.h"
+
+namespace {
 
 struct Connector {
     unsigned long side1;
@@ -28,65 +34,74 @@ Connector toConnector(const std::string& text) {
     return {std::stoul(side1), std::stoul(side2)};
 }
 
+// every candidate carries its own copy of the connectors left, so the queue and those copies all live in an arena
+using Remaining = std::pmr::vector<Connector>;
+
 // bridge, strength, remaining
-using Candidate = std::tuple<unsigned long, unsigned long, std::vector<Connector>>;
+using Candidate = std::tuple<unsigned long, unsigned long, Remaining>;
 
-unsigned long getStrongestBridge(std::span<Connector> connectors) {
+unsigned long getStrongestBridge(std::span<Connector> connectors, std::pmr::memory_resource* resource) {
+    AOC_SCOPE("day 24 strongest bridge");
 
     auto isCandidateLessThan = [](const auto& candidate1, const auto& candidate2){
         return std::get<1>(candidate1) < std::get<1>(candidate2);
     };
  
-    std::priority_queue<Candidate, std::vector<Candidate>, decltype(isCandidateLessThan)> candidates;
-    candidates.push(Candidate{0, 0, {connectors.begin(), connectors.end()}});
+    std::priority_queue<Candidate, std::pmr::vector<Candidate>, decltype(isCandidateLessThan)> candidates(isCandidateLessThan, std::pmr::vector<Candidate>(resource));
+    candidates.emplace(0, 0, Remaining(connectors.begin(), connectors.end(), resource));
     unsigned long maxStrength = 0;
     while(!candidates.empty()) {
-        auto [bridge, strength, remaining] = candidates.top();
+        const auto [bridge, strength] = std::pair(std::get<0>(candidates.top()), std::get<1>(candidates.top()));
+        const Remaining remaining(std::get<2>(candidates.top()), resource);
         candidates.pop();
+        AOC_COUNT("day 24 candidates explored", 1);
 
         auto matches = remaining | std::views::filter([bridge](const auto& c){
             return c.side1 == bridge || c.side2 == bridge;
         });
         
         for(const auto& match : matches){
-            std::vector<Connector> newRemaining{remaining};
+            Remaining newRemaining(remaining, resource);
             newRemaining.erase(std::ranges::find(newRemaining, match));
             unsigned long newBridge = (bridge == match.side1) ? match.side2 : match.side1;
             unsigned long newStrength = strength + match.getStrength();
             maxStrength = std::max(maxStrength, newStrength);
-            candidates.emplace(newBridge, newStrength, newRemaining);
+            candidates.emplace(newBridge, newStrength, std::move(newRemaining));
         }
     }
 
     return maxStrength;
 }
 
-using NewCandidate = std::tuple<unsigned long, unsigned long, unsigned long, std::vector<Connector>>;
+using NewCandidate = std::tuple<unsigned long, unsigned long, unsigned long, Remaining>;
 
-unsigned long getLongestStrongestBridge(std::span<Connector> connectors) {
+unsigned long getLongestStrongestBridge(std::span<Connector> connectors, std::pmr::memory_resource* resource) {
+    AOC_SCOPE("day 24 longest strongest bridge");
 
     auto isCandidateLessThan = [](const auto& candidate1, const auto& candidate2){
         return std::get<1>(candidate1) < std::get<1>(candidate2);
     };
  
-    std::priority_queue<NewCandidate, std::vector<NewCandidate>, decltype(isCandidateLessThan)> candidates;
-    candidates.push(NewCandidate{0, 0, 0, {connectors.begin(), connectors.end()}});
+    std::priority_queue<NewCandidate, std::pmr::vector<NewCandidate>, decltype(isCandidateLessThan)> candidates(isCandidateLessThan, std::pmr::vector<NewCandidate>(resource));
+    candidates.emplace(0, 0, 0, Remaining(connectors.begin(), connectors.end(), resource));
     std::pair<unsigned long, unsigned long> longestAndStrongest {0, 0};
     while(!candidates.empty()) {
-        auto [bridge, length, strength, remaining] = candidates.top();
+        const auto [bridge, length, strength] = std::tuple(std::get<0>(candidates.top()), std::get<1>(candidates.top()), std::get<2>(candidates.top()));
+        const Remaining remaining(std::get<3>(candidates.top()), resource);
         candidates.pop();
+        AOC_COUNT("day 24 candidates explored", 1);
 
         auto matches = remaining | std::views::filter([bridge](const auto& c){
             return c.side1 == bridge || c.side2 == bridge;
         });
         
         for(const auto& match : matches){
-            std::vector<Connector> newRemaining{remaining};
+            Remaining newRemaining(remaining, resource);
             newRemaining.erase(std::ranges::find(newRemaining, match));
             unsigned long newBridge = (bridge == match.side1) ? match.side2 : match.side1;
             unsigned long newStrength = strength + match.getStrength();
             longestAndStrongest = std::max(longestAndStrongest, std::make_pair(length + 1, newStrength));
-            candidates.emplace(newBridge, length + 1, newStrength, newRemaining);
+            candidates.emplace(newBridge, length + 1, newStrength, std::move(newRemaining));
         }
     }
 
@@ -94,8 +109,14 @@ unsigned long getLongestStrongestBridge(std::span<Connector> connectors) {
 }
 
 
-int main() {
+void solve(runner::Context& context) {
+    arena::Arena arena;
     auto connectors = algo::map(input::readMultiLineFile("input/input24.txt"), toConnector);
-    std::cout << getStrongestBridge(connectors) << "\n";
-    std::cout << getLongestStrongestBridge(connectors) << "\n";
-}
\ No newline at end of file
+    context.startPhase(runner::Phase::Part1);
+    context.out << getStrongestBridge(connectors, arena.resource()) << "\n";
+    context.startPhase(runner::Phase::Part2);
+    context.out << getLongestStrongestBridge(connectors, arena.resource()) << "\n";
+}
+}
+
+AOC_DAY("24", solve)
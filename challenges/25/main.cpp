@@ -1,13 +1,17 @@
 #include <cassert>
 #include <iostream>
+#include <memory_resource>
 #include <regex>
 #include <set>
 #include <span>
 #include <string>
 #include <unordered_map>
 
+#include "arena.h"
 #include "input.h"
+#include "runner.h"
 
+namespace {
 
 enum class Direction {
     Left,
@@ -22,7 +26,8 @@ struct Action {
 
 class TuringMachine {
 public: 
-    TuringMachine(std::span<std::string> instructions){
+    // the tape is a set of the positions holding a one, with its nodes in the arena since cells flip on most steps
+    TuringMachine(std::span<std::string> instructions, std::pmr::memory_resource* resource) : oneValues(resource) {
         startingState = *(instructions[0].rbegin() + 1); 
 
         std::regex numberOfStepsRegex{ "Perform a diagnostic checksum after (\\d+) steps."};
@@ -74,13 +79,17 @@ private:
     char startingState;
     unsigned long numberOfSteps;
     std::unordered_map<char, std::pair<Action, Action>> stateToActionMapping;
-    std::set<int> oneValues;
+    std::pmr::set<int> oneValues;
 };
 
-int main() {
+void solve(runner::Context& context) {
+    arena::Arena arena;
     auto instructions = input::readMultiLineFile("input/input25.txt");
-    TuringMachine turingMachine(instructions);
+    TuringMachine turingMachine(instructions, arena.resource());
+    context.startPhase(runner::Phase::Part1);
     turingMachine.run();
-    std::cout << "Diagnostic Checksum: " << turingMachine.getNumberOfOnes() << "\n";
-    return 0;
-}
\ No newline at end of file
+    context.out << "Diagnostic Checksum: " << turingMachine.getNumberOfOnes() << "\n";
+}
+}
+
+AOC_DAY("25", solve)
@@ -2,9 +2,23 @@
 #define ALGO_H_
 
 #include <algorithm>
+#include <iterator>
+#include <cmath>
+#include <numeric>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "concurrency.h"
+
 namespace algo {
+    // pass as the first argument to spread the work over the shared thread pool
+    struct parallel_policy {};
+    inline constexpr parallel_policy parallel{};
+
     auto zip(auto container1, auto container2) {
         auto iter1 = container1.begin();
         auto iter2 = container2.begin();
@@ -33,6 +47,170 @@ namespace algo {
         return out;
     }
 
+    namespace detail {
+        // every value is tried against every other value, but in descending order so the bigger number is tried as the dividend first
+        template<typename T>
+        bool for_each_divisible_pair_pairwise(std::span<const T> descending, auto emit) {
+            for(auto iter1 = descending.begin(); iter1 != descending.end(); ++iter1) {
+                for(auto iter2 = iter1+1; iter2 != descending.end(); ++iter2) {
+                    if(*iter2 != 0 && *iter1 % *iter2 == 0 && emit(*iter1, *iter2, 1)) {
+                        return true;
+                    }
+                    if(*iter1 != 0 && *iter2 % *iter1 == 0 && emit(*iter2, *iter1, 1)) {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        // for positive values a divisor is either equal to the dividend or at most half of it,
+        // so in descending order everything between the dividend and its half can be skipped with a binary search
+        template<typename T>
+        bool for_each_divisible_pair_sorted(std::span<const T> descending, auto emit) {
+            for(auto iter1 = descending.begin(); iter1 != descending.end(); ++iter1) {
+                auto iter2 = iter1+1;
+                for(; iter2 != descending.end() && *iter2 == *iter1; ++iter2) {
+                    if(emit(*iter1, *iter2, 2)) {
+                        return true;
+                    }
+                }
+                iter2 = std::lower_bound(iter2, descending.end(), *iter1 / 2, std::greater<T>());
+                for(; iter2 != descending.end(); ++iter2) {
+                    if(*iter1 % *iter2 == 0 && emit(*iter1, *iter2, 1)) {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        // for positive values with a small maximum: mark which values are present, then walk the multiples of each value
+        template<typename T>
+        bool for_each_divisible_pair_sieve(const std::vector<T>& descending, auto emit) {
+            std::vector<unsigned int> counts(static_cast<size_t>(descending.front()) + 1, 0u);
+            for(auto value: descending) {
+                ++counts[value];
+            }
+            for(auto iter = descending.rbegin(); iter != descending.rend(); ++iter) {
+                const auto divisor = *iter;
+                if(std::next(iter) != descending.rend() && *std::next(iter) == divisor) {
+                    continue; // only look at each distinct value once
+                }
+                // equal values divide each other, which find_matching_pairs reports in both directions
+                if(counts[divisor] > 1 && emit(divisor, divisor, counts[divisor] * (counts[divisor] - 1))) {
+                    return true;
+                }
+                for(auto multiple = static_cast<size_t>(divisor) * 2; multiple < counts.size(); multiple += divisor) {
+                    if(counts[multiple] != 0 && emit(static_cast<T>(multiple), divisor, counts[multiple] * counts[divisor])) {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        // for positive values too big to sieve: bucket the values, then look up every divisor of each value up to its square root
+        template<typename T>
+        bool for_each_divisible_pair_bucketed(const std::vector<T>& descending, auto emit) {
+            std::unordered_map<T, unsigned int> counts;
+            for(auto value: descending) {
+                ++counts[value];
+            }
+            for(const auto& [dividend, dividendCount]: counts) {
+                if(dividendCount > 1 && emit(dividend, dividend, dividendCount * (dividendCount - 1))) {
+                    return true;
+                }
+                for(T divisor = 1; divisor <= dividend / divisor; ++divisor) {
+                    if(dividend % divisor != 0) {
+                        continue;
+                    }
+                    for(auto candidate: {divisor, static_cast<T>(dividend / divisor)}) {
+                        auto match = counts.find(candidate);
+                        if(candidate != dividend && match != counts.end() && emit(dividend, candidate, dividendCount * match->second)) {
+                            return true;
+                        }
+                        // candidate divides dividend, so this is candidate * candidate == dividend without the overflow
+                        if(candidate == dividend / candidate) {
+                            break;
+                        }
+                    }
+                }
+            }
+            return false;
+        }
+
+        // emit(dividend, divisor, multiplicity) is called for every distinct pair found, and returning true stops the search
+        template<typename T>
+        void for_each_divisible_pair(std::vector<T> values, auto emit) {
+            if(values.size() < 2) {
+                return;
+            }
+            std::sort(values.begin(), values.end(), std::greater<T>());
+            const auto largest = values.front();
+            const auto smallest = values.back();
+            const auto n = values.size();
+
+            if(smallest <= 0) {
+                for_each_divisible_pair_pairwise<T>(values, emit);
+            }
+            else if(static_cast<size_t>(largest) <= 64 * n + 4096) {
+                for_each_divisible_pair_sieve(values, emit);
+            }
+            else if(static_cast<size_t>(std::sqrt(static_cast<double>(largest))) < n / 4) {
+                for_each_divisible_pair_bucketed(values, emit);
+            }
+            else {
+                for_each_divisible_pair_sorted<T>(values, emit);
+            }
+        }
+    }
+
+    // every (dividend, divisor) pair where dividend % divisor == 0
+    // the same pairs as find_matching_pairs(container, [](auto a, auto b) { return a % b == 0; }), though not in the same order
+    auto find_divisible_pairs(const auto& container) {
+        using ContainerType = typename std::decay_t<decltype(container)>::value_type;
+        std::vector<std::pair<ContainerType, ContainerType>> out;
+        detail::for_each_divisible_pair(std::vector<ContainerType>(container.begin(), container.end()), [&out](auto dividend, auto divisor, unsigned int multiplicity) {
+            out.insert(out.end(), multiplicity, std::make_pair(dividend, divisor));
+            return false;
+        });
+        return out;
+    }
+
+    // stops at the first pair, for when only one pair is expected
+    auto find_first_divisible_pair(const auto& container) {
+        using ContainerType = typename std::decay_t<decltype(container)>::value_type;
+        std::optional<std::pair<ContainerType, ContainerType>> out;
+        detail::for_each_divisible_pair(std::vector<ContainerType>(container.begin(), container.end()), [&out](auto dividend, auto divisor, unsigned int) {
+            out = std::make_pair(dividend, divisor);
+            return true;
+        });
+        return out;
+    }
+
+    // same as find_first_divisible_pair, but sorts the values where they are rather than copying them,
+    // and only uses the searches that don't allocate, for when it is called once per row of something big
+    template<typename T>
+    std::optional<std::pair<T, T>> find_first_divisible_pair_in_place(std::span<T> values) {
+        std::optional<std::pair<T, T>> out;
+        if(values.size() < 2) {
+            return out;
+        }
+        std::sort(values.begin(), values.end(), std::greater<T>());
+        auto emit = [&out](auto dividend, auto divisor, unsigned int) {
+            out = std::make_pair(dividend, divisor);
+            return true;
+        };
+        if(values.back() <= 0) {
+            detail::for_each_divisible_pair_pairwise<T>(values, emit);
+        }
+        else {
+            detail::for_each_divisible_pair_sorted<T>(values, emit);
+        }
+        return out;
+    }
+
     auto map(auto container, auto rowOperation) {
         using ContainerType = typename decltype(container.begin())::value_type;
         using ReturnType = typename std::invoke_result_t<decltype(rowOperation), ContainerType>;
@@ -41,6 +219,45 @@ namespace algo {
         return v;
     }
 
+    // same as map, but the container is cut into slices that are mapped on the shared thread pool
+    // the output keeps the input order, and the operation must be safe to call from several threads at once
+    auto map(parallel_policy, const auto& container, auto rowOperation) {
+        using ContainerType = typename std::decay_t<decltype(container)>::value_type;
+        using ReturnType = typename std::invoke_result_t<decltype(rowOperation), ContainerType>;
+        auto slices = concurrency::mapSlices(container.size(), [&container, &rowOperation](size_t begin, size_t end) {
+            std::vector<ReturnType> v;
+            v.reserve(end - begin);
+            std::transform(std::next(container.begin(), begin), std::next(container.begin(), end), std::back_inserter(v), rowOperation);
+            return v;
+        });
+
+        std::vector<ReturnType> v;
+        v.reserve(container.size());
+        for(auto& slice: slices) {
+            std::move(slice.begin(), slice.end(), std::back_inserter(v));
+        }
+        return v;
+    }
+
+    auto map_reduce(const auto& container, auto mapOperation, auto init, auto reduceOperation) {
+        return std::accumulate(container.begin(), container.end(), init, [&mapOperation, &reduceOperation](auto sum, const auto& value) {
+            return reduceOperation(sum, mapOperation(value));
+        });
+    }
+
+    // each slice is reduced on its own and the partial results are then reduced in order,
+    // so reduceOperation has to be associative, but it doesn't need to be commutative
+    auto map_reduce(parallel_policy, const auto& container, auto mapOperation, auto init, auto reduceOperation) {
+        using ResultType = decltype(init);
+        auto partials = concurrency::mapSlices(container.size(), [&container, &mapOperation, &reduceOperation](size_t begin, size_t end) {
+            auto first = std::next(container.begin(), begin);
+            return std::accumulate(std::next(first), std::next(container.begin(), end), static_cast<ResultType>(mapOperation(*first)), [&mapOperation, &reduceOperation](ResultType sum, const auto& value) {
+                return static_cast<ResultType>(reduceOperation(sum, mapOperation(value)));
+            });
+        });
+        return std::accumulate(partials.begin(), partials.end(), init, reduceOperation);
+    }
+
     auto range(auto start, auto end) {
         using RangeType = decltype(start);
         static_assert(std::is_same<RangeType, decltype(end)>::value, "Start and end must be the same type for range functions");
@@ -81,6 +298,72 @@ namespace algo {
         }
         return r;
     }
+
+    // lazy counterparts of zip, map and range
+    // nothing is copied or allocated up front, elements are produced one at a time as the result is iterated
+    namespace lazy {
+        template<std::ranges::view View1, std::ranges::view View2>
+        class zip_view : public std::ranges::view_interface<zip_view<View1, View2>> {
+        public:
+            class sentinel;
+
+            class iterator {
+            public:
+                using value_type = std::pair<std::ranges::range_value_t<View1>, std::ranges::range_value_t<View2>>;
+                using difference_type = std::ptrdiff_t;
+
+                iterator() = default;
+                iterator(std::ranges::iterator_t<View1> iter1, std::ranges::iterator_t<View2> iter2) : iter1(std::move(iter1)), iter2(std::move(iter2)) {}
+
+                value_type operator*() const { return value_type(*iter1, *iter2); }
+                iterator& operator++() { ++iter1; ++iter2; return *this; }
+                iterator operator++(int) { auto old = *this; ++*this; return old; }
+                bool operator==(const iterator& rhs) const { return iter1 == rhs.iter1 && iter2 == rhs.iter2; }
+                bool isAtEnd(const std::ranges::sentinel_t<View1>& end1, const std::ranges::sentinel_t<View2>& end2) const { return iter1 == end1 || iter2 == end2; }
+
+            private:
+                std::ranges::iterator_t<View1> iter1;
+                std::ranges::iterator_t<View2> iter2;
+            };
+
+            // like the eager zip, iteration stops as soon as either range runs out
+            class sentinel {
+            public:
+                sentinel() = default;
+                sentinel(std::ranges::sentinel_t<View1> end1, std::ranges::sentinel_t<View2> end2) : end1(std::move(end1)), end2(std::move(end2)) {}
+
+                friend bool operator==(const iterator& iter, const sentinel& s) { return iter.isAtEnd(s.end1, s.end2); }
+
+            private:
+                std::ranges::sentinel_t<View1> end1;
+                std::ranges::sentinel_t<View2> end2;
+            };
+
+            zip_view() = default;
+            zip_view(View1 view1, View2 view2) : view1(std::move(view1)), view2(std::move(view2)) {}
+
+            iterator begin() { return iterator(std::ranges::begin(view1), std::ranges::begin(view2)); }
+            sentinel end() { return sentinel(std::ranges::end(view1), std::ranges::end(view2)); }
+
+        private:
+            View1 view1;
+            View2 view2;
+        };
+
+        // lvalue arguments are referenced rather than copied, so they have to outlive the result
+        auto zip(auto&& range1, auto&& range2) {
+            return zip_view(std::views::all(std::forward<decltype(range1)>(range1)), std::views::all(std::forward<decltype(range2)>(range2)));
+        }
+
+        auto map(auto&& range, auto operation) {
+            return std::views::transform(std::forward<decltype(range)>(range), std::move(operation));
+        }
+
+        auto range(auto start, auto end) {
+            static_assert(std::is_same<decltype(start), decltype(end)>::value, "Start and end must be the same type for range functions");
+            return std::views::iota(start, end);
+        }
+    }
 }
 
 #endif
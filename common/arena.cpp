@@ -0,0 +1,9 @@
+#include "arena.h"
+
+namespace arena {
+    Arena::Arena(size_t initialSize) : monotonic(initialSize), pool(&monotonic) {}
+
+    std::pmr::memory_resource* Arena::resource() {
+        return &pool;
+    }
+}
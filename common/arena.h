@@ -0,0 +1,28 @@
+#ifndef ARENA_H_
+#define ARENA_H_
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace arena {
+    // memory for one run of a solver, handed to containers as a std::pmr::memory_resource
+    // blocks come out of a monotonic buffer that is only given back when the arena goes, and a pool on top of it
+    // keeps freed blocks by size, so containers that insert and erase all the time reuse nodes rather than asking for more
+    // not thread safe, an arena belongs to one solver on one thread
+    // a pmr container copied without an allocator goes back to the default resource, so copies have to name the arena or be moves
+    class Arena {
+    public:
+        explicit Arena(size_t initialSize = 64 * 1024);
+
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        std::pmr::memory_resource* resource();
+
+    private:
+        std::pmr::monotonic_buffer_resource monotonic;
+        std::pmr::unsynchronized_pool_resource pool;
+    };
+}
+
+#endif
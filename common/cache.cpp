@@ -0,0 +1,50 @@
+#include "cache.h"
+
+#include <cstdio>
+
+namespace cache {
+    // FNV-1a a byte at a time, with the length folded in and the bits mixed at the end
+    // every byte goes through the multiply on its own, so no part of the input is left with only a weak say in the result
+    uint64_t hash(std::string_view data) {
+        constexpr uint64_t PRIME = 0x100000001b3;
+        uint64_t h = 0xcbf29ce484222325;
+        for(auto c: data) {
+            h = (h ^ static_cast<unsigned char>(c)) * PRIME;
+        }
+        h ^= data.size();
+        h = (h ^ (h >> 33)) * 0xff51afd7ed558ccd;
+        h = (h ^ (h >> 33)) * 0xc4ceb9fe1a85ec53;
+        return h ^ (h >> 33);
+    }
+
+    bool isValid(std::string_view cacheContents, uint32_t layoutVersion, uint64_t inputHash, uint64_t inputSize, size_t elementSize) {
+        if(cacheContents.size() < sizeof(Header)) {
+            return false;
+        }
+        Header header;
+        std::memcpy(&header, cacheContents.data(), sizeof(Header));
+        return header.magic == MAGIC &&
+               header.formatVersion == FORMAT_VERSION &&
+               header.layoutVersion == layoutVersion &&
+               header.inputHash == inputHash &&
+               header.inputSize == inputSize &&
+               header.elementSize == elementSize &&
+               cacheContents.size() == sizeof(Header) + header.count * elementSize;
+    }
+
+    // the cache is only an optimization, so failing to write it is not an error
+    // it is written to a temporary file first so a half written cache is never picked up
+    void write(const std::string& cacheFileName, const Header& header, const void* data, size_t size) {
+        const auto temporaryFileName = cacheFileName + ".tmp";
+        {
+            std::ofstream outFile(temporaryFileName, std::ios::binary | std::ios::trunc);
+            outFile.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+            outFile.write(static_cast<const char*>(data), size);
+            if(!outFile) {
+                std::remove(temporaryFileName.c_str());
+                return;
+            }
+        }
+        std::rename(temporaryFileName.c_str(), cacheFileName.c_str());
+    }
+}
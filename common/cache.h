@@ -0,0 +1,96 @@
+#ifndef CACHE_H_
+#define CACHE_H_
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "input.h"
+
+// binary cache of parsed inputs, stored next to the input as <input>.cache
+// the cache file is a Header followed by the parsed values exactly as they sit in memory, so loading it is just a mapping
+namespace cache {
+    constexpr uint64_t MAGIC = 0x4548434143434f41; // "AOCCACHE" as it appears in the file
+    constexpr uint32_t FORMAT_VERSION = 2u;
+
+    // the padding up to the cache line is spelled out, so a header built with braces has no uninitialized bytes to write
+    struct alignas(64) Header {
+        uint64_t magic;
+        uint32_t formatVersion;
+        uint32_t layoutVersion;
+        uint64_t inputHash;
+        uint64_t inputSize;
+        uint64_t elementSize;
+        uint64_t count;
+        std::array<uint8_t, 16> reserved{};
+    };
+    static_assert(sizeof(Header) == 64 && std::has_unique_object_representations_v<Header>, "Header must not have any implicit padding");
+
+    uint64_t hash(std::string_view data);
+
+    template<typename T>
+    class CachedArray {
+    public:
+        static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types can be cached");
+
+        explicit CachedArray(input::MappedFile&& mapping) : mapping(std::move(mapping)) {
+            const auto contents = this->mapping->contents();
+            const auto header = reinterpret_cast<const Header*>(contents.data());
+            view = std::span<const T>(reinterpret_cast<const T*>(contents.data() + sizeof(Header)), header->count);
+        }
+        explicit CachedArray(std::vector<T>&& values) : built(std::move(values)), view(built) {}
+
+        CachedArray(CachedArray&&) = default;
+        CachedArray& operator=(CachedArray&&) = default;
+
+        std::span<const T> values() const {
+            return view;
+        }
+
+        bool wasLoadedFromCache() const {
+            return mapping.has_value();
+        }
+
+    private:
+        std::optional<input::MappedFile> mapping;
+        std::vector<T> built;
+        std::span<const T> view;
+    };
+
+    // layoutVersion belongs to the caller and should be bumped whenever T or the way it is built changes
+    bool isValid(std::string_view cacheContents, uint32_t layoutVersion, uint64_t inputHash, uint64_t inputSize, size_t elementSize);
+    void write(const std::string& cacheFileName, const Header& header, const void* data, size_t size);
+
+    // maps the cached values if the cache matches the input, otherwise runs build over the input text and caches the result
+    template<typename T>
+    CachedArray<T> loadOrBuild(const std::string& inputFileName, uint32_t layoutVersion, auto build) {
+        const auto cacheFileName = inputFileName + ".cache";
+        const input::MappedFile inputFile(inputFileName);
+        const auto inputHash = hash(inputFile.contents());
+
+        try {
+            input::MappedFile cacheFile(cacheFileName);
+            if(isValid(cacheFile.contents(), layoutVersion, inputHash, inputFile.contents().size(), sizeof(T))) {
+                return CachedArray<T>(std::move(cacheFile));
+            }
+        }
+        catch(std::runtime_error&) {
+            // no cache yet
+        }
+
+        std::vector<T> values = build(inputFile.contents());
+        const Header header { MAGIC, FORMAT_VERSION, layoutVersion, inputHash, inputFile.contents().size(), sizeof(T), values.size() };
+        write(cacheFileName, header, values.data(), values.size() * sizeof(T));
+        return CachedArray<T>(std::move(values));
+    }
+}
+
+#endif
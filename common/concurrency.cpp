@@ -0,0 +1,54 @@
+#include "concurrency.h"
+
+namespace concurrency {
+    namespace {
+        thread_local bool isPoolWorker = false;
+    }
+
+    ThreadPool::ThreadPool(unsigned int numberOfThreads) {
+        for(auto i = 0u; i < numberOfThreads; ++i) {
+            workers.emplace_back([this]() { work(); });
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        taskAvailable.notify_all();
+        for(auto& worker: workers) {
+            worker.join();
+        }
+    }
+
+    unsigned int ThreadPool::size() const {
+        return workers.size();
+    }
+
+    bool ThreadPool::isWorkerThread() {
+        return isPoolWorker;
+    }
+
+    void ThreadPool::work() {
+        isPoolWorker = true;
+        while(true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                taskAvailable.wait(lock, [this]() { return stopping || !tasks.empty(); });
+                if(tasks.empty()) {
+                    return;
+                }
+                task = std::move(tasks.front());
+                tasks.pop();
+            }
+            task();
+        }
+    }
+
+    ThreadPool& sharedPool() {
+        static ThreadPool pool;
+        return pool;
+    }
+}
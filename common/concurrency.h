@@ -0,0 +1,92 @@
+#ifndef CONCURRENCY_H_
+#define CONCURRENCY_H_
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace concurrency {
+    class ThreadPool {
+    public:
+        explicit ThreadPool(unsigned int numberOfThreads = std::max(1u, std::thread::hardware_concurrency()));
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        // a task submitted from one of the pool's own threads runs straight away on that thread
+        // otherwise a task that waits on its own subtasks could wait forever on a fully busy pool
+        template<typename Task>
+        auto submit(Task task) {
+            using ReturnType = std::invoke_result_t<Task>;
+            auto packagedTask = std::make_shared<std::packaged_task<ReturnType()>>(std::move(task));
+            auto future = packagedTask->get_future();
+            if(isWorkerThread()) {
+                (*packagedTask)();
+                return future;
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                tasks.emplace([packagedTask]() { (*packagedTask)(); });
+            }
+            taskAvailable.notify_one();
+            return future;
+        }
+
+        unsigned int size() const;
+        static bool isWorkerThread();
+
+    private:
+        void work();
+
+        std::vector<std::thread> workers;
+        std::queue<std::function<void()>> tasks;
+        std::mutex mutex;
+        std::condition_variable taskAvailable;
+        bool stopping = false;
+    };
+
+    // one pool for the whole process, sized to the number of cores
+    ThreadPool& sharedPool();
+
+    // every future is waited on before any result is taken, so if one task throws
+    // none of the others can still be running against state owned by the caller
+    template<typename T>
+    std::vector<T> getAll(std::vector<std::future<T>>& futures) {
+        for(auto& future: futures) {
+            future.wait();
+        }
+        std::vector<T> results;
+        results.reserve(futures.size());
+        for(auto& future: futures) {
+            results.push_back(future.get());
+        }
+        return results;
+    }
+
+    // runs operation(begin, end) over slices of [0, size) on the shared pool, results come back in slice order
+    // there are a few slices per thread so uneven work still keeps every core busy
+    template<typename Operation>
+    auto mapSlices(size_t size, Operation operation) {
+        using ReturnType = std::invoke_result_t<Operation, size_t, size_t>;
+        auto& pool = sharedPool();
+        const auto numberOfSlices = std::min<size_t>(size, pool.size() * 4);
+
+        std::vector<std::future<ReturnType>> futures;
+        for(auto slice = 0u; slice < numberOfSlices; ++slice) {
+            const auto begin = size * slice / numberOfSlices;
+            const auto end = size * (slice + 1) / numberOfSlices;
+            futures.push_back(pool.submit([&operation, begin, end]() { return operation(begin, end); }));
+        }
+        return getAll(futures);
+    }
+}
+
+#endif
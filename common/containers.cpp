@@ -0,0 +1,100 @@
+#include "containers.h"
+
+#include <bit>
+#include <numeric>
+#include <stdexcept>
+
+namespace containers {
+
+    BitGrid::BitGrid(size_t width, size_t height) :
+        width(width), height(height), wordsPerRow((width + 63) / 64), words(wordsPerRow * height, 0u) {}
+
+    bool BitGrid::get(size_t x, size_t y) const {
+        return (words[y * wordsPerRow + x / 64] >> (63 - x % 64)) & 1u;
+    }
+
+    void BitGrid::set(size_t x, size_t y, bool value) {
+        const auto mask = uint64_t{1} << (63 - x % 64);
+        auto& word = words[y * wordsPerRow + x / 64];
+        word = value ? word | mask : word & ~mask;
+    }
+
+    void BitGrid::setBytes(size_t y, size_t firstByte, std::span<const uint8_t> bytes) {
+        if((firstByte + bytes.size()) * 8 > width || y >= height) {
+            throw std::out_of_range("bytes do not fit in the grid");
+        }
+        auto* row = words.data() + y * wordsPerRow;
+        for(auto i = 0u; i < bytes.size(); ++i) {
+            const auto column = (firstByte + i) * 8;
+            const auto shift = 56 - column % 64;
+            auto& word = row[column / 64];
+            word = (word & ~(uint64_t{0xFF} << shift)) | (uint64_t{bytes[i]} << shift);
+        }
+    }
+
+    size_t BitGrid::count() const {
+        return std::transform_reduce(words.begin(), words.end(), size_t{0}, std::plus<>(), [](uint64_t word) { return std::popcount(word); });
+    }
+
+    size_t BitGrid::findNext(const uint64_t* row, size_t x, bool value) const {
+        while(x < width) {
+            // flip the word when looking for zeros so either search is a count of leading zeros
+            const auto word = (value ? row[x / 64] : ~row[x / 64]) << (x % 64);
+            if(word != 0u) {
+                return std::min(width, x + std::countl_zero(word));
+            }
+            x = (x / 64 + 1) * 64;
+        }
+        return width;
+    }
+
+    // each row is cut into runs of set bits, and runs that touch a run in the row above are merged with union-find
+    // only the runs of two rows are kept around, so this is a single pass over the words
+    size_t BitGrid::countRegions() const {
+        struct Run {
+            size_t begin;
+            size_t end;
+            size_t label;
+        };
+
+        std::vector<size_t> parents;
+        auto find = [&parents](size_t label) {
+            while(parents[label] != label) {
+                parents[label] = parents[parents[label]];
+                label = parents[label];
+            }
+            return label;
+        };
+
+        auto numberOfRegions = size_t{0};
+        std::vector<Run> previous, current;
+        for(auto y = 0u; y < height; ++y) {
+            const auto* row = words.data() + y * wordsPerRow;
+            current.clear();
+            auto above = previous.begin();
+            for(auto begin = findNext(row, 0, true); begin < width; begin = findNext(row, begin, true)) {
+                const auto end = findNext(row, begin, false);
+                const auto label = parents.size();
+                parents.push_back(label);
+                ++numberOfRegions;
+
+                // runs above that finish before this one starts can't touch this or any later run
+                while(above != previous.end() && above->end <= begin) {
+                    ++above;
+                }
+                for(auto overlap = above; overlap != previous.end() && overlap->begin < end; ++overlap) {
+                    const auto root = find(overlap->label);
+                    const auto ownRoot = find(label);
+                    if(root != ownRoot) {
+                        parents[ownRoot] = root;
+                        --numberOfRegions;
+                    }
+                }
+                current.push_back({begin, end, label});
+                begin = end;
+            }
+            std::swap(previous, current);
+        }
+        return numberOfRegions;
+    }
+}
@@ -1,6 +1,13 @@
+#ifndef CONTAINERS_H_
+#define CONTAINERS_H_
+
 #include <array>
+#include <cstdint>
 #include <ostream>
+#include <span>
 #include <sstream>
+#include <string>
+#include <utility>
 #include <vector>
 
 
@@ -31,25 +38,42 @@ namespace containers {
         std::vector<T> range(unsigned int b, unsigned int e) {
             std::vector<T> out;
             for(auto i = b; i < e; ++i) {
-                out.push_back(a[(begin+i) % Size]);
+                out.push_back(a[wrap(begin+i)]);
             }
             return out;
         }
 
+        // reverses length elements starting at b in place, wrapping around the end of the buffer as needed
+        void reverse(unsigned int b, unsigned int length) {
+            for(auto i = 0u; i < length / 2; ++i) {
+                std::swap(a[wrap(begin + b + i)], a[wrap(begin + b + length - 1 - i)]);
+            }
+        }
+
         T& operator[](unsigned int index) { 
-            return a[index % Size];
+            return a[wrap(index)];
         }
 
         std::string to_string() const {
             std::string out = "";
             for(auto i = 0u; i < Size; ++i) {
-                out += std::to_string(a[(begin+i) % Size]) + " ";
+                out += std::to_string(a[wrap(begin+i)]) + " ";
             }
             return out;
         }
 
 
     private:
+        // a power of two size can wrap with a mask instead of a division
+        static constexpr unsigned int wrap(unsigned int index) {
+            if constexpr ((Size & (Size - 1)) == 0) {
+                return index & (Size - 1);
+            }
+            else {
+                return index % Size;
+            }
+        }
+
         bool hasWrappedAround = false;
         std::array<T, Size> a;
         unsigned int begin = 0u;
@@ -62,5 +86,36 @@ namespace containers {
         os << cb.to_string() << "\n";
         return os;
     }
+
+    // a width x height grid of bits, 64 to a word, with each row starting on a fresh word
+    // bits are stored most significant first, so bytes copied in big-endian order land in reading order
+    class BitGrid {
+    public:
+        BitGrid(size_t width, size_t height);
+
+        size_t getWidth() const { return width; }
+        size_t getHeight() const { return height; }
+
+        bool get(size_t x, size_t y) const;
+        void set(size_t x, size_t y, bool value = true);
+
+        // overwrites the row with the bits of bytes, starting at column firstByte * 8
+        void setBytes(size_t y, size_t firstByte, std::span<const uint8_t> bytes);
+
+        size_t count() const;
+
+        // number of groups of set bits joined up, down, left or right
+        size_t countRegions() const;
+
+    private:
+        // the first column from x onwards whose bit equals value, or width if there isn't one
+        size_t findNext(const uint64_t* row, size_t x, bool value) const;
+
+        size_t width;
+        size_t height;
+        size_t wordsPerRow;
+        std::vector<uint64_t> words;
+    };
 }
 
+#endif
@@ -2,9 +2,14 @@
 #include "crypto.h"
 
 #include <algorithm>
-#include <numeric>
+#include <cstring>
+#include <string_view>
+#include <unordered_map>
 
-#include "algo.h"
+#include "cache.h"
+#include "concurrency.h"
+#include "instrument.h"
+#include "simd.h"
 
 namespace crypto {
 
@@ -24,11 +29,7 @@ namespace crypto {
         auto start = 0u;
             for(auto i = 0u; i < rounds; ++i){
             for(auto lineLength: lineLengths) {
-                auto range = cb->range(start, start+lineLength);
-                std::reverse(range.begin(), range.end());
-                for(auto i = 0; i < lineLength; ++i) {
-                    (*cb)[start+i] = range[i];
-                }
+                cb->reverse(start, lineLength);
                 start += lineLength + skipSize++;
 
             }
@@ -37,20 +38,284 @@ namespace crypto {
     }
 
     std::vector<unsigned int> calculateDenseHash(const std::string& input) {
+        const auto denseHash = knotHash(input);
+        return std::vector<unsigned int>(denseHash.begin(), denseHash.end());
+    }
 
-        auto newLineLengths = algo::map(input, [](char c){ return static_cast<int>(c);});
-        newLineLengths.push_back(17);
-        newLineLengths.push_back(31);
-        newLineLengths.push_back(73);
-        newLineLengths.push_back(47);
-        newLineLengths.push_back(23);
-        
-        auto values = createHashedCircularBuffer(newLineLengths, 64u)->range(0,256);
-        std::vector<unsigned int> out;
-        for(auto i = 0; i < 16; ++i){
-            auto xorValue = std::accumulate(values.begin()+i*16, values.begin()+i*16+16, 0u, std::bit_xor<unsigned int>());
-            out.push_back(xorValue);
+    namespace {
+        constexpr std::array<uint8_t, 5> SUFFIX = {17, 31, 73, 47, 23};
+
+        // one hash in flight, with its state rotated so that state[0] is always the current position
+        struct Lane {
+            alignas(32) std::array<uint8_t, 256> state;
+            alignas(32) std::array<uint8_t, 512> doubled;
+            std::string_view key;
+            unsigned int position = 0u;
+            unsigned int skipSize = 0u;
+
+            size_t getNumberOfLengths() const {
+                return key.size() + SUFFIX.size();
+            }
+
+            unsigned int getLength(size_t index) const {
+                return index < key.size() ? static_cast<uint8_t>(key[index]) : SUFFIX[index - key.size()];
+            }
+
+            void reset(std::string_view newKey) {
+                for(auto i = 0u; i < state.size(); ++i) {
+                    state[i] = static_cast<uint8_t>(i);
+                }
+                key = newKey;
+                position = 0u;
+                skipSize = 0u;
+            }
+
+            // undo the rotation to get back to the real list before folding it into the dense hash
+            KnotHash getDenseHash() const {
+                KnotHash denseHash{};
+                for(auto i = 0u; i < state.size(); ++i) {
+                    denseHash[i / 16] ^= state[(i - position) & 0xFF];
+                }
+                return denseHash;
+            }
+        };
+
+        // every lane does its rounds in step with the others, so the CPU always has several independent hashes to work on
+        template<typename Step>
+        void hashLanes(std::span<Lane> lanes, Step step) {
+            size_t numberOfLengths = 0u;
+            for(const auto& lane: lanes) {
+                numberOfLengths = std::max(numberOfLengths, lane.getNumberOfLengths());
+            }
+            for(auto round = 0u; round < 64; ++round) {
+                for(auto index = 0u; index < numberOfLengths; ++index) {
+                    for(auto& lane: lanes) {
+                        if(index < lane.getNumberOfLengths()) {
+                            step(lane, lane.getLength(index));
+                        }
+                    }
+                }
+            }
+        }
+
+#ifdef AOC_SIMD
+        // swaps bytes from both ends of [begin, end) inwards until they meet, for what's left after the vector loop
+        void reverseTail(uint8_t* state, unsigned int begin, unsigned int end) {
+            while(begin + 1 < end) {
+                std::swap(state[begin++], state[--end]);
+            }
+        }
+
+        __attribute__((target("ssse3")))
+        void stepSsse3(Lane& lane, unsigned int length) {
+            const __m128i reverseBytes = _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+            uint8_t* state = lane.state.data();
+
+            // swap 16 byte blocks from both ends, reversing each block on the way
+            auto begin = 0u;
+            auto end = length;
+            for(; end - begin >= 32; begin += 16, end -= 16) {
+                const auto front = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state + begin));
+                const auto back = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state + end - 16));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(state + begin), _mm_shuffle_epi8(back, reverseBytes));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(state + end - 16), _mm_shuffle_epi8(front, reverseBytes));
+            }
+            // 16 to 31 bytes left: two overlapping blocks, both loaded before either is stored
+            if(end - begin >= 16) {
+                const auto front = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state + begin));
+                const auto back = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state + end - 16));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(state + begin), _mm_shuffle_epi8(back, reverseBytes));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(state + end - 16), _mm_shuffle_epi8(front, reverseBytes));
+            }
+            else {
+                reverseTail(state, begin, end);
+            }
+
+            // rotate left by writing the state out twice and reading it back from the new start
+            const auto rotation = (length + lane.skipSize) & 0xFF;
+            uint8_t* doubled = lane.doubled.data();
+            for(auto i = 0u; i < 256; i += 16) {
+                const auto block = _mm_load_si128(reinterpret_cast<const __m128i*>(state + i));
+                _mm_store_si128(reinterpret_cast<__m128i*>(doubled + i), block);
+                _mm_store_si128(reinterpret_cast<__m128i*>(doubled + 256 + i), block);
+            }
+            for(auto i = 0u; i < 256; i += 16) {
+                _mm_store_si128(reinterpret_cast<__m128i*>(state + i), _mm_loadu_si128(reinterpret_cast<const __m128i*>(doubled + rotation + i)));
+            }
+            lane.position += length + lane.skipSize++;
+        }
+
+        __attribute__((target("avx2")))
+        __m256i reverse32(__m256i block) {
+            const __m256i reverseBytes = _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+                                                          15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+            // the byte shuffle only works within each 128 bit half, so the halves are swapped afterwards
+            const auto reversedHalves = _mm256_shuffle_epi8(block, reverseBytes);
+            return _mm256_permute2x128_si256(reversedHalves, reversedHalves, 1);
+        }
+
+        __attribute__((target("avx2")))
+        void stepAvx2(Lane& lane, unsigned int length) {
+            uint8_t* state = lane.state.data();
+
+            auto begin = 0u;
+            auto end = length;
+            for(; end - begin >= 64; begin += 32, end -= 32) {
+                const auto front = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + begin));
+                const auto back = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + end - 32));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(state + begin), reverse32(back));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(state + end - 32), reverse32(front));
+            }
+            if(end - begin >= 32) {
+                const auto front = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + begin));
+                const auto back = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + end - 32));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(state + begin), reverse32(back));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(state + end - 32), reverse32(front));
+            }
+            else {
+                reverseTail(state, begin, end);
+            }
+
+            const auto rotation = (length + lane.skipSize) & 0xFF;
+            uint8_t* doubled = lane.doubled.data();
+            for(auto i = 0u; i < 256; i += 32) {
+                const auto block = _mm256_load_si256(reinterpret_cast<const __m256i*>(state + i));
+                _mm256_store_si256(reinterpret_cast<__m256i*>(doubled + i), block);
+                _mm256_store_si256(reinterpret_cast<__m256i*>(doubled + 256 + i), block);
+            }
+            for(auto i = 0u; i < 256; i += 32) {
+                _mm256_store_si256(reinterpret_cast<__m256i*>(state + i), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(doubled + rotation + i)));
+            }
+            lane.position += length + lane.skipSize++;
+        }
+#endif
+
+        using StepFunction = void (*)(Lane&, unsigned int);
+    }
+
+    std::vector<KnotHash> knotHashBatch(std::span<const std::string> keys) {
+        std::vector<KnotHash> out;
+        out.reserve(keys.size());
+
+        static const auto step = simd::select<StepFunction>({
+#ifdef AOC_SIMD
+            {simd::Feature::Avx2, stepAvx2},
+            {simd::Feature::Ssse3, stepSsse3},
+#endif
+        }, nullptr);
+        if(step == nullptr) {
+            std::transform(keys.begin(), keys.end(), std::back_inserter(out), [](const std::string& key) { return knotHash(key); });
+            return out;
+        }
+
+        constexpr size_t LANES = 4;
+        std::array<Lane, LANES> lanes;
+        for(size_t first = 0u; first < keys.size(); first += LANES) {
+            const auto numberOfLanes = std::min(LANES, keys.size() - first);
+            for(auto i = 0u; i < numberOfLanes; ++i) {
+                lanes[i].reset(keys[first + i]);
+            }
+            hashLanes(std::span<Lane>(lanes.data(), numberOfLanes), step);
+            for(auto i = 0u; i < numberOfLanes; ++i) {
+                out.push_back(lanes[i].getDenseHash());
+            }
+        }
+        return out;
+    }
+
+    std::vector<KnotHash> knotHashParallel(std::span<const std::string> keys) {
+        auto slices = concurrency::mapSlices(keys.size(), [keys](size_t begin, size_t end) {
+            return knotHashBatch(keys.subspan(begin, end - begin));
+        });
+        std::vector<KnotHash> out;
+        out.reserve(keys.size());
+        for(const auto& slice: slices) {
+            out.insert(out.end(), slice.begin(), slice.end());
+        }
+        return out;
+    }
+
+    // the file is a cache::Header followed by the entries, there is no input behind it so the input hash and size are always 0
+    HashCache::HashCache(std::string fileName) : fileName(std::move(fileName)) {
+        try {
+            input::MappedFile cacheFile(this->fileName);
+            const auto contents = cacheFile.contents();
+            if(!cache::isValid(contents, LAYOUT_VERSION, 0u, 0u, sizeof(Entry))) {
+                return;
+            }
+            const auto count = (contents.size() - sizeof(cache::Header)) / sizeof(Entry);
+            digests.reserve(count);
+            for(auto i = 0u; i < count; ++i) {
+                Entry entry;
+                std::memcpy(&entry, contents.data() + sizeof(cache::Header) + i * sizeof(Entry), sizeof(Entry));
+                if(entry.keyLength <= MAX_SAVED_KEY_LENGTH) {
+                    digests.emplace(std::string(entry.key.data(), entry.keyLength), entry.digest);
+                }
+            }
+        }
+        catch(std::runtime_error&) {
+            // nothing saved yet
+        }
+    }
+
+    std::vector<KnotHash> HashCache::get(std::span<const std::string> keys) {
+        // each key is looked up once: a hit keeps a pointer to its digest, which stays put as more digests are added,
+        // and a miss keeps its place in the list of keys to hash, so a key repeated within one call is only hashed the first time
+        std::vector<const KnotHash*> found(keys.size(), nullptr);
+        std::vector<size_t> missingIndices(keys.size(), 0u);
+        std::vector<std::string> missingKeys;
+        std::unordered_map<std::string_view, size_t> missingKeyIndices;
+        for(auto i = 0u; i < keys.size(); ++i) {
+            const auto match = digests.find(keys[i]);
+            if(match != digests.end()) {
+                found[i] = &match->second;
+                continue;
+            }
+            const auto [missing, isNew] = missingKeyIndices.try_emplace(keys[i], missingKeys.size());
+            if(isNew) {
+                missingKeys.push_back(keys[i]);
+            }
+            missingIndices[i] = missing->second;
+        }
+
+        const auto missingDigests = knotHashParallel(missingKeys);
+        std::vector<const KnotHash*> added;
+        added.reserve(missingKeys.size());
+        for(auto i = 0u; i < missingKeys.size(); ++i) {
+            added.push_back(&digests.try_emplace(std::move(missingKeys[i]), missingDigests[i]).first->second);
+        }
+        misses += added.size();
+        hits += keys.size() - added.size();
+        AOC_COUNT("knot hash cache misses", added.size());
+        AOC_COUNT("knot hash cache hits", keys.size() - added.size());
+
+        std::vector<KnotHash> out;
+        out.reserve(keys.size());
+        for(auto i = 0u; i < keys.size(); ++i) {
+            out.push_back(found[i] != nullptr ? *found[i] : *added[missingIndices[i]]);
         }
         return out;
     }
-}
\ No newline at end of file
+
+    void HashCache::save() const {
+        if(fileName.empty()) {
+            return;
+        }
+        std::vector<Entry> entries;
+        entries.reserve(digests.size());
+        for(const auto& [key, digest]: digests) {
+            if(key.size() > MAX_SAVED_KEY_LENGTH) {
+                continue;
+            }
+            Entry entry{digest, static_cast<uint8_t>(key.size()), {}};
+            std::copy(key.begin(), key.end(), entry.key.begin());
+            entries.push_back(entry);
+        }
+        const cache::Header header { cache::MAGIC, cache::FORMAT_VERSION, LAYOUT_VERSION, 0u, 0u, sizeof(Entry), entries.size() };
+        cache::write(fileName, header, entries.data(), entries.size() * sizeof(Entry));
+    }
+
+    // known answers from the puzzle text, checked while compiling
+    static_assert(knotHash("") == KnotHash{0xa2, 0x58, 0x2a, 0x3a, 0x0e, 0x66, 0xe6, 0xe8, 0x6e, 0x38, 0x12, 0xdc, 0xb6, 0x72, 0xa2, 0x72});
+    static_assert(knotHash("AoC 2017") == KnotHash{0x33, 0xef, 0xeb, 0x34, 0xea, 0x91, 0x90, 0x2b, 0xb2, 0xf5, 0x9c, 0x99, 0x20, 0xca, 0xa6, 0xcd});
+}
@@ -1,14 +1,96 @@
 #ifndef CRYPTO_H_
 #define CRYPTO_H_
 
+#include <array>
+#include <cstdint>
 #include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
 
 #include "containers.h"
 #include <vector>
 namespace crypto {
+    using KnotHash = std::array<uint8_t, 16>;
+
     std::unique_ptr<containers::CircularBuffer<unsigned int, 256>> createCircularBuffer();
     std::unique_ptr<containers::CircularBuffer<unsigned int, 256>> createHashedCircularBuffer(const std::vector<int> & lineLengths, unsigned int rounds=1u);
     std::vector<unsigned int> calculateDenseHash(const std::string & input);
-        
+
+    // the same hash as calculateDenseHash, worked out in a stack buffer with no allocation at all
+    // it is constexpr, so hashes of fixed keys can be computed at compile time
+    constexpr KnotHash knotHash(std::string_view input) {
+        constexpr std::array<uint8_t, 5> suffix = {17, 31, 73, 47, 23};
+        std::array<uint8_t, 256> values{};
+        for(auto i = 0u; i < values.size(); ++i) {
+            values[i] = static_cast<uint8_t>(i);
+        }
+
+        auto position = 0u;
+        auto skipSize = 0u;
+        auto reverse = [&values, &position, &skipSize](unsigned int length) {
+            for(auto i = 0u; i < length / 2; ++i) {
+                std::swap(values[(position + i) & 0xFF], values[(position + length - 1 - i) & 0xFF]);
+            }
+            position += length + skipSize++;
+        };
+
+        for(auto round = 0u; round < 64; ++round) {
+            for(auto c: input) {
+                reverse(static_cast<uint8_t>(c));
+            }
+            for(auto length: suffix) {
+                reverse(length);
+            }
+        }
+
+        KnotHash denseHash{};
+        for(auto i = 0u; i < values.size(); ++i) {
+            denseHash[i / 16] ^= values[i];
+        }
+        return denseHash;
+    }
+
+    // knotHash over many keys at once, with several hashes interleaved so they progress in lockstep
+    // on x86 each hash keeps its state rotated so every reversal starts at index 0, which makes reversing
+    // and rotating whole-vector shuffles (AVX2 or SSSE3, picked at run time); elsewhere it is knotHash per key
+    std::vector<KnotHash> knotHashBatch(std::span<const std::string> keys);
+
+    // knotHashBatch with the keys split into slices across the shared thread pool, results in key order
+    std::vector<KnotHash> knotHashParallel(std::span<const std::string> keys);
+
+    // remembers the hash of every key it has seen, only the misses are hashed (in parallel)
+    // given a file name the digests are loaded from it on construction and written back by save
+    // keys are stored and compared in full, but only keys of up to MAX_SAVED_KEY_LENGTH characters are saved to the file
+    // not thread safe, the parallelism is all inside get
+    class HashCache {
+    public:
+        HashCache() = default;
+        explicit HashCache(std::string fileName);
+
+        std::vector<KnotHash> get(std::span<const std::string> keys);
+        void save() const;
+
+        size_t getHits() const { return hits; }
+        size_t getMisses() const { return misses; }
+
+        static constexpr size_t MAX_SAVED_KEY_LENGTH = 47;
+
+    private:
+        // fixed size so the file is a plain array of entries, the key is padded with zeros
+        struct Entry {
+            KnotHash digest;
+            uint8_t keyLength;
+            std::array<char, MAX_SAVED_KEY_LENGTH> key;
+        };
+        static constexpr uint32_t LAYOUT_VERSION = 2u;
+
+        std::string fileName;
+        std::unordered_map<std::string, KnotHash> digests;
+        size_t hits = 0u;
+        size_t misses = 0u;
+    };
 }
-#endif
\ No newline at end of file
+#endif
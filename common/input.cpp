@@ -1,63 +1,273 @@
 #include "input.h"
 
-#include <fstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <charconv>
+#include <stdexcept>
 #include <type_traits>
+#include <utility>
 
 namespace input {
-    std::string readSingleLineFile(const std::string& fileName) {
-        std::ifstream inFile;
-        inFile.open(fileName);
+    MappedFile::MappedFile(const std::string& fileName) {
+        const int fd = open(fileName.c_str(), O_RDONLY);
+        if(fd == -1) {
+            throw std::runtime_error("Could not open " + fileName);
+        }
 
-        if(inFile.eof()) {
-            throw std::runtime_error("The file should not have been empty)");
+        struct stat fileStat;
+        if(fstat(fd, &fileStat) == -1) {
+            close(fd);
+            throw std::runtime_error("Could not stat " + fileName);
+        }
+
+        size = static_cast<size_t>(fileStat.st_size);
+        // mmap refuses zero-length mappings, so an empty file is just an empty view
+        if(size != 0u) {
+            void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(mapping == MAP_FAILED) {
+                close(fd);
+                throw std::runtime_error("Could not map " + fileName);
+            }
+            madvise(mapping, size, MADV_SEQUENTIAL);
+            data = static_cast<const char*>(mapping);
+        }
+        close(fd);
+    }
+
+    MappedFile::~MappedFile() {
+        if(data != nullptr) {
+            munmap(const_cast<char*>(data), size);
+        }
+    }
+
+    MappedFile::MappedFile(MappedFile&& rhs) noexcept : data(std::exchange(rhs.data, nullptr)), size(std::exchange(rhs.size, 0u)) {}
+
+    MappedFile& MappedFile::operator=(MappedFile&& rhs) noexcept {
+        std::swap(data, rhs.data);
+        std::swap(size, rhs.size);
+        return *this;
+    }
+
+    std::string_view MappedFile::contents() const {
+        return std::string_view(data, size);
+    }
+
+    std::string_view MappedFile::firstLine() const {
+        const auto text = contents();
+        return text.substr(0, text.find('\n'));
+    }
+
+    std::vector<std::string_view> MappedFile::lines() const {
+        return splitLines(contents());
+    }
+
+    std::vector<std::string_view> splitLines(std::string_view text) {
+        std::vector<std::string_view> v;
+        v.reserve(std::count(text.begin(), text.end(), '\n') + 1);
+        while(!text.empty()) {
+            const auto newline = text.find('\n');
+            const auto line = text.substr(0, newline);
+            if(!line.empty()) {
+                v.push_back(line);
+            }
+            text.remove_prefix(newline == std::string_view::npos ? text.size() : newline + 1);
+        }
+        return v;
+    }
+
+    std::vector<std::string_view> splitIntoChunks(std::string_view text, size_t numberOfChunks) {
+        std::vector<std::string_view> chunks;
+        const auto chunkSize = text.size() / std::max<size_t>(numberOfChunks, 1u) + 1;
+        while(!text.empty()) {
+            const auto newline = text.find('\n', std::min(chunkSize, text.size()) - 1);
+            const auto end = (newline == std::string_view::npos) ? text.size() : newline + 1;
+            chunks.push_back(text.substr(0, end));
+            text.remove_prefix(end);
+        }
+        return chunks;
+    }
+
+    LineStream::LineStream(const std::string& fileName, size_t bufferSize) : inFile(fileName, std::ios::binary), buffer(bufferSize) {
+        // an empty buffer could never be filled, so next would spin forever
+        if(bufferSize == 0u) {
+            throw std::invalid_argument("LineStream needs a buffer of at least one byte");
+        }
+        if(!inFile.is_open()) {
+            throw std::runtime_error("Could not open " + fileName);
+        }
+    }
+
+    bool LineStream::next(std::string_view& line) {
+        while(true) {
+            const auto start = buffer.begin() + position;
+            const auto newline = std::find(start, buffer.begin() + filled, '\n');
+            if(newline != buffer.begin() + filled) {
+                line = std::string_view(&*start, std::distance(start, newline));
+                position += line.size() + 1;
+                if(!line.empty()) {
+                    return true;
+                }
+                continue;
+            }
+            if(!fill()) {
+                // whatever is left over is the last line of a file that doesn't end in a newline
+                line = std::string_view(buffer.data() + position, filled - position);
+                position = filled;
+                return !line.empty();
+            }
+        }
+    }
+
+    bool LineStream::nextLines(std::string_view& lines) {
+        while(true) {
+            const auto unread = std::string_view(buffer.data() + position, filled - position);
+            const auto lastNewline = unread.rfind('\n');
+            if(lastNewline != std::string_view::npos) {
+                lines = unread.substr(0, lastNewline);
+                position += lastNewline + 1;
+                return true;
+            }
+            if(!fill()) {
+                lines = std::string_view(buffer.data() + position, filled - position);
+                position = filled;
+                return !lines.empty();
+            }
         }
+    }
 
-        std::string input;
-        getline(inFile, input);
-        return input;
+    // keeps the unfinished line at the front of the buffer and reads more after it
+    bool LineStream::fill() {
+        if(!inFile) {
+            return false;
+        }
+        std::copy(buffer.begin() + position, buffer.begin() + filled, buffer.begin());
+        filled -= position;
+        position = 0u;
+        if(filled == buffer.size()) {
+            buffer.resize(buffer.size() * 2);
+        }
+        inFile.read(buffer.data() + filled, buffer.size() - filled);
+        filled += inFile.gcount();
+        return inFile.gcount() != 0;
+    }
+
+    std::string readSingleLineFile(const std::string& fileName) {
+        const MappedFile file(fileName);
+        const auto line = file.firstLine();
+        if(line.empty()) {
+            throw std::runtime_error("The file should not have been empty)");
+        }
+        return std::string(line);
     }
 
     std::vector<std::string> readMultiLineFile(const std::string& fileName) {
-        std::ifstream inFile;
-        inFile.open(fileName);
-
-        std::vector<std::string> v;
-        while(!inFile.eof()) {
-            std::string input;
-            getline(inFile, input);
-            if(input != ""){
-                v.push_back(input);
+        const MappedFile file(fileName);
+        const auto lines = file.lines();
+        return std::vector<std::string>(lines.begin(), lines.end());
+    }
+
+    namespace {
+        bool isWhitespace(char c) {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+        }
+
+        // pulls the next whitespace separated token off the front of str, empty once there is nothing left
+        std::string_view nextToken(std::string_view& str) {
+            const auto start = std::find_if_not(str.begin(), str.end(), isWhitespace);
+            const auto end = std::find_if(start, str.end(), isWhitespace);
+            const auto token = std::string_view(start, end);
+            str.remove_prefix(std::distance(str.begin(), end));
+            return token;
+        }
+
+        // mirrors getline: empty tokens in the middle are kept, but a trailing delimiter doesn't produce one
+        template<typename Operation>
+        void forEachToken(std::string_view str, char delimiter, Operation operation) {
+            while(!str.empty()) {
+                const auto end = str.find(delimiter);
+                operation(str.substr(0, end));
+                str.remove_prefix(end == std::string_view::npos ? str.size() : end + 1);
             }
         }
 
-        return v;
+        template<typename Operation>
+        void forEachToken(std::string_view str, Operation operation) {
+            for(auto token = nextToken(str); !token.empty(); token = nextToken(str)) {
+                operation(token);
+            }
+        }
     }
 
-    std::vector<std::string> split(const std::string& str){
-        std::istringstream iss(str);
-        std::vector<std::string> v((std::istream_iterator<std::string>(iss)), std::istream_iterator<std::string>());
+    std::vector<std::string> split(std::string_view str){
+        const auto tokens = tokenize(str);
+        return std::vector<std::string>(tokens.begin(), tokens.end());
+    }
+
+    std::vector<std::string> split(std::string_view str, char delimiter){
+        const auto tokens = tokenize(str, delimiter);
+        return std::vector<std::string>(tokens.begin(), tokens.end());
+    }
+
+    std::vector<std::string_view> tokenize(std::string_view str) {
+        std::vector<std::string_view> v;
+        forEachToken(str, [&v](std::string_view token) { v.push_back(token); });
         return v;
     }
 
-    std::vector<std::string> split(const std::string& str, char delimiter){
-        std::istringstream iss(str);
-        std::vector<std::string> v;
-        std::string token;
-        while(std::getline(iss, token, delimiter)) {
-            v.push_back(token);
-        }
+    std::vector<std::string_view> tokenize(std::string_view str, char delimiter) {
+        std::vector<std::string_view> v;
+        forEachToken(str, delimiter, [&v](std::string_view token) { v.push_back(token); });
         return v;
     }
 
-    std::vector<int> toNumbers(const std::string &str) {
-        auto v = split(str);
+    size_t parseNumbers(std::string_view str, std::vector<int>& out) {
+        const auto originalSize = out.size();
+        forEachToken(str, [&out](std::string_view token) { out.push_back(toNumber(token)); });
+        return out.size() - originalSize;
+    }
+
+    size_t parseNumbers(std::string_view str, char delimiter, std::vector<int>& out) {
+        const auto originalSize = out.size();
+        forEachToken(str, delimiter, [&out](std::string_view token) { out.push_back(toNumber(token)); });
+        return out.size() - originalSize;
+    }
+
+    size_t parseNumbers(std::string_view str, std::span<int> out) {
+        auto count = 0u;
+        forEachToken(str, [&out, &count](std::string_view token) {
+            if(count == out.size()) {
+                throw std::invalid_argument("Too many numbers for the output span");
+            }
+            out[count++] = toNumber(token);
+        });
+        return count;
+    }
+
+    std::vector<int> toNumbers(std::string_view str) {
         std::vector<int> out;
-        std::transform(v.begin(), v.end(), std::back_inserter(out), toNumber );
+        parseNumbers(str, out);
         return out;
     }
 
-    int toNumber(std::string str) {
-        return std::stoi(str);
+    // like std::stoi, leading whitespace is skipped and anything after the digits is ignored
+    int toNumber(std::string_view str) {
+        str.remove_prefix(std::distance(str.begin(), std::find_if_not(str.begin(), str.end(), isWhitespace)));
+        if(!str.empty() && str.front() == '+') {
+            str.remove_prefix(1);
+        }
+
+        int value = 0;
+        const auto [end, error] = std::from_chars(str.data(), str.data() + str.size(), value);
+        if(error == std::errc::invalid_argument) {
+            throw std::invalid_argument("Not a number: " + std::string(str));
+        }
+        if(error == std::errc::result_out_of_range) {
+            throw std::out_of_range("Number out of range: " + std::string(str));
+        }
+        return value;
     }
 
     std::string dropTrailingComma(const std::string &s) {
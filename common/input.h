@@ -2,20 +2,159 @@
 #define INPUT_H_
 
 #include <algorithm>
+#include <fstream>
 #include <iterator>
 #include <string>
+#include <span>
 #include <sstream>
+#include <string_view>
 #include <vector>
 
+#include "algo.h"
+#include "concurrency.h"
+
 namespace input {
+    // read-only memory mapping of a whole file
+    // the views handed out point straight into the mapping, so they are only valid while the MappedFile is alive
+    class MappedFile {
+    public:
+        //will throw an exception if the file is not found or cannot be mapped
+        explicit MappedFile(const std::string& fileName);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&& rhs) noexcept;
+        MappedFile& operator=(MappedFile&& rhs) noexcept;
+
+        std::string_view contents() const;
+        std::string_view firstLine() const;
+        // empty lines are skipped, same as readMultiLineFile
+        std::vector<std::string_view> lines() const;
+
+    private:
+        const char* data = nullptr;
+        size_t size = 0u;
+    };
+
+    std::vector<std::string_view> splitLines(std::string_view text);
+
+    // reads a file a buffer at a time so memory use doesn't depend on the size of the file
+    // empty lines are skipped, and each line is a view into the buffer that is only valid until the stream advances
+    class LineStream {
+    public:
+        class Iterator {
+        public:
+            using value_type = std::string_view;
+            using difference_type = std::ptrdiff_t;
+
+            Iterator() = default;
+            explicit Iterator(LineStream* stream) : stream(stream) { ++*this; }
+
+            std::string_view operator*() const { return line; }
+            Iterator& operator++() {
+                if(!stream->next(line)) {
+                    stream = nullptr;
+                }
+                return *this;
+            }
+            void operator++(int) { ++*this; }
+            bool operator==(std::default_sentinel_t) const { return stream == nullptr; }
+
+        private:
+            LineStream* stream = nullptr;
+            std::string_view line;
+        };
+
+        //will throw an exception if the file is not found or the buffer size is 0
+        explicit LineStream(const std::string& fileName, size_t bufferSize = 64 * 1024);
+
+        // lines longer than the buffer grow it rather than being cut in two
+        bool next(std::string_view& line);
+        // every whole line left in the buffer at once, still separated by newlines and with any empty lines kept
+        bool nextLines(std::string_view& lines);
+
+        Iterator begin() { return Iterator(this); }
+        std::default_sentinel_t end() const { return std::default_sentinel; }
+
+    private:
+        bool fill();
+
+        std::ifstream inFile;
+        std::vector<char> buffer;
+        size_t position = 0u;
+        size_t filled = 0u;
+    };
+
+    // cuts text into at most numberOfChunks pieces of roughly equal size, only ever cutting just after a newline
+    std::vector<std::string_view> splitIntoChunks(std::string_view text, size_t numberOfChunks);
+
+    // runs parser over every non-empty line on the shared thread pool, results come back in file order
+    // parser is called from several threads at once, so it must not touch shared state
+    auto parseLinesParallel(std::string_view text, auto parser) {
+        using ReturnType = std::invoke_result_t<decltype(parser), std::string_view>;
+        auto& pool = concurrency::sharedPool();
+
+        // a few chunks per thread keeps every core busy when some lines are slower than others
+        const auto chunks = splitIntoChunks(text, pool.size() * 4);
+        std::vector<std::future<std::vector<ReturnType>>> parsedChunks;
+        for(const auto& chunk: chunks) {
+            parsedChunks.push_back(pool.submit([chunk, &parser]() {
+                const auto lines = splitLines(chunk);
+                std::vector<ReturnType> out;
+                out.reserve(lines.size());
+                std::transform(lines.begin(), lines.end(), std::back_inserter(out), parser);
+                return out;
+            }));
+        }
+
+        std::vector<ReturnType> out;
+        for(auto& values: concurrency::getAll(parsedChunks)) {
+            std::move(values.begin(), values.end(), std::back_inserter(out));
+        }
+        return out;
+    }
+
+    // streams the file a block of whole lines at a time and maps a batch of blocks at once on the shared pool,
+    // so memory use stays at one batch however big the file is
+    // the results are reduced in file order, and mapOperation must be safe to call from several threads at once
+    auto mapReduceLineBlocks(const std::string& fileName, auto mapOperation, auto init, auto reduceOperation) {
+        LineStream stream(fileName);
+        std::vector<std::string> blocks(concurrency::sharedPool().size() * 4);
+        auto total = init;
+        auto isDone = false;
+        while(!isDone) {
+            auto count = 0u;
+            std::string_view lines;
+            while(count < blocks.size() && stream.nextLines(lines)) {
+                blocks[count++].assign(lines);
+            }
+            isDone = count < blocks.size();
+            total = algo::map_reduce(algo::parallel, std::span(blocks).first(count), mapOperation, total, reduceOperation);
+        }
+        return total;
+    }
+
     //will throw an exception if the file is not found or if the file is empty
     std::string readSingleLineFile(const std::string& fileName);    
     std::vector<std::string> readMultiLineFile(const std::string& fileName);
     
-    std::vector<std::string> split(const std::string& str);
-    std::vector<std::string> split(const std::string& str, char delimiter);
-    std::vector<int> toNumbers(const std::string & str);
-    int toNumber(std::string s);
+    std::vector<std::string> split(std::string_view str);
+    std::vector<std::string> split(std::string_view str, char delimiter);
+
+    // same splitting rules as split, but the tokens are views into str rather than copies
+    std::vector<std::string_view> tokenize(std::string_view str);
+    std::vector<std::string_view> tokenize(std::string_view str, char delimiter);
+
+    // parse numbers straight out of the text with no intermediate strings
+    // the vector overloads append to out, the span overload fills it from the front
+    // all of them return how many numbers were parsed and throw std::invalid_argument on anything that isn't a number
+    size_t parseNumbers(std::string_view str, std::vector<int>& out);
+    size_t parseNumbers(std::string_view str, char delimiter, std::vector<int>& out);
+    size_t parseNumbers(std::string_view str, std::span<int> out);
+
+    std::vector<int> toNumbers(std::string_view str);
+    int toNumber(std::string_view s);
     std::string dropTrailingComma(const std::string& str);
 
     std::string join(const std::vector<std::string>& v, std::string delimiter="");
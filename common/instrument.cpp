@@ -0,0 +1,137 @@
+#include "instrument.h"
+
+#ifdef AOC_INSTRUMENT
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace instrument {
+    namespace {
+        std::atomic<Site*> sites{nullptr};
+        std::atomic<uint64_t> totalAllocations{0u};
+        std::atomic<uint64_t> totalBytes{0u};
+        thread_local Site* innermostScope = nullptr;
+
+        void recordAllocation(std::size_t size) {
+            totalAllocations.fetch_add(1u, std::memory_order_relaxed);
+            totalBytes.fetch_add(size, std::memory_order_relaxed);
+            if(innermostScope != nullptr) {
+                innermostScope->allocations.fetch_add(1u, std::memory_order_relaxed);
+                innermostScope->bytes.fetch_add(size, std::memory_order_relaxed);
+            }
+        }
+
+        bool isSameSite(const Site& lhs, const Site& rhs) {
+            return lhs.kind == rhs.kind && std::strcmp(lhs.name, rhs.name) == 0;
+        }
+
+        // adds up every site named like first, unless an earlier one in the list already has that name
+        bool isFirstOfName(const Site& first) {
+            for(auto* site = sites.load(); site != &first; site = site->next) {
+                if(isSameSite(*site, first)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        struct Totals {
+            unsigned long long calls = 0u;
+            double milliseconds = 0.0;
+            unsigned long long allocations = 0u;
+            unsigned long long bytes = 0u;
+        };
+
+        Totals getTotals(const Site& first) {
+            Totals totals;
+            for(auto* site = &first; site != nullptr; site = site->next) {
+                if(isSameSite(*site, first)) {
+                    totals.calls += site->calls.load();
+                    totals.milliseconds += site->nanoseconds.load() / 1e6;
+                    totals.allocations += site->allocations.load();
+                    totals.bytes += site->bytes.load();
+                }
+            }
+            return totals;
+        }
+
+        // printf rather than iostreams, the streams may already be gone when this runs
+        struct Summary {
+            ~Summary() {
+                std::fprintf(stderr, "\n%-40s %12s %12s %14s %16s\n", "scope", "calls", "ms", "allocations", "bytes");
+                std::fprintf(stderr, "%-40s %12s %12s %14llu %16llu\n", "(whole process)", "", "",
+                             static_cast<unsigned long long>(totalAllocations.load()), static_cast<unsigned long long>(totalBytes.load()));
+                for(auto* site = sites.load(); site != nullptr; site = site->next) {
+                    if(site->kind == Site::Kind::Scope && isFirstOfName(*site)) {
+                        const auto totals = getTotals(*site);
+                        std::fprintf(stderr, "%-40s %12llu %12.3f %14llu %16llu\n", site->name, totals.calls, totals.milliseconds, totals.allocations, totals.bytes);
+                    }
+                }
+                std::fprintf(stderr, "\n%-40s %12s\n", "counter", "count");
+                for(auto* site = sites.load(); site != nullptr; site = site->next) {
+                    if(site->kind == Site::Kind::Counter && isFirstOfName(*site)) {
+                        std::fprintf(stderr, "%-40s %12llu\n", site->name, getTotals(*site).calls);
+                    }
+                }
+            }
+        } summary;
+    }
+
+    Site::Site(const char* name, Kind kind) : name(name), kind(kind) {
+        next = sites.load();
+        while(!sites.compare_exchange_weak(next, this)) {}
+    }
+
+    Scope::Scope(Site& site) : site(site), outer(innermostScope), start(std::chrono::steady_clock::now()) {
+        innermostScope = &site;
+    }
+
+    Scope::~Scope() {
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        site.calls.fetch_add(1u, std::memory_order_relaxed);
+        site.nanoseconds.fetch_add(elapsed.count(), std::memory_order_relaxed);
+        innermostScope = outer;
+    }
+
+    uint64_t allocationCount() {
+        return totalAllocations.load(std::memory_order_relaxed);
+    }
+}
+
+void* operator new(std::size_t size) {
+    instrument::recordAllocation(size);
+    if(auto* memory = std::malloc(size == 0u ? 1u : size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    instrument::recordAllocation(size);
+    // aligned_alloc wants a size that is a multiple of the alignment
+    const auto align = static_cast<std::size_t>(alignment);
+    if(auto* memory = std::aligned_alloc(align, (size + align - 1) / align * align)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept {
+    std::free(memory);
+}
+
+#endif
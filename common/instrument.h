@@ -0,0 +1,77 @@
+#ifndef INSTRUMENT_H_
+#define INSTRUMENT_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// opt-in instrumentation, everything here compiles away to nothing unless AOC_INSTRUMENT is defined
+//
+//   AOC_SCOPE("day 24 bridges");          times the rest of the block and counts what it allocates
+//   AOC_COUNT("vm instructions", 1);      adds to a named counter
+//
+// with it defined, global operator new is replaced to count allocations and bytes, both in total and against
+// the innermost scope open on the allocating thread, and a summary of every scope and counter goes to stderr at exit
+// allocations made on other threads (say by the thread pool) belong to whatever scope those threads have open
+namespace instrument {
+#ifdef AOC_INSTRUMENT
+    // one per AOC_SCOPE or AOC_COUNT in the source, linked into a list as they are first reached
+    // sites are statics that never allocate, so they can be updated from inside operator new
+    // sites with the same name are added together in the summary
+    struct Site {
+        enum class Kind { Scope, Counter };
+        Site(const char* name, Kind kind);
+
+        const char* name;
+        Kind kind;
+        std::atomic<uint64_t> calls{0u};
+        std::atomic<uint64_t> nanoseconds{0u};
+        std::atomic<uint64_t> allocations{0u};
+        std::atomic<uint64_t> bytes{0u};
+        Site* next = nullptr;
+    };
+
+    class Scope {
+    public:
+        explicit Scope(Site& site);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        Site& site;
+        Site* outer;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    inline void count(Site& site, uint64_t amount) {
+        site.calls.fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    // every allocation in the process so far
+    uint64_t allocationCount();
+#else
+    inline uint64_t allocationCount() {
+        return 0u;
+    }
+#endif
+}
+
+#ifdef AOC_INSTRUMENT
+#define AOC_INSTRUMENT_CONCATENATE_(a, b) a##b
+#define AOC_INSTRUMENT_CONCATENATE(a, b) AOC_INSTRUMENT_CONCATENATE_(a, b)
+#define AOC_SCOPE(name) \
+    static instrument::Site AOC_INSTRUMENT_CONCATENATE(instrumentSite, __LINE__)(name, instrument::Site::Kind::Scope); \
+    const instrument::Scope AOC_INSTRUMENT_CONCATENATE(instrumentScope, __LINE__)(AOC_INSTRUMENT_CONCATENATE(instrumentSite, __LINE__))
+#define AOC_COUNT(name, amount) \
+    do { \
+        static instrument::Site instrumentSite(name, instrument::Site::Kind::Counter); \
+        instrument::count(instrumentSite, amount); \
+    } while(false)
+#else
+#define AOC_SCOPE(name) static_cast<void>(0)
+#define AOC_COUNT(name, amount) static_cast<void>(0)
+#endif
+
+#endif
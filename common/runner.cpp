@@ -0,0 +1,52 @@
+#include "runner.h"
+
+#include <iostream>
+#include <stdexcept>
+
+namespace runner {
+    Context::Context(std::ostream& out, std::function<uint64_t()> allocationCounter) :
+        out(out), allocationCounter(std::move(allocationCounter)), phaseStart(std::chrono::steady_clock::now()), phaseStartAllocations(countAllocations()) {}
+
+    uint64_t Context::countAllocations() const {
+        return allocationCounter ? allocationCounter() : 0u;
+    }
+
+    void Context::startPhase(Phase nextPhase) {
+        if(finished) {
+            throw std::logic_error("Day has already finished");
+        }
+        const auto now = std::chrono::steady_clock::now();
+        const auto allocations = countAllocations();
+        auto& result = results[static_cast<size_t>(phase)];
+        result.milliseconds += std::chrono::duration<double, std::milli>(now - phaseStart).count();
+        result.allocations += allocations - phaseStartAllocations;
+
+        phase = nextPhase;
+        phaseStart = now;
+        phaseStartAllocations = allocations;
+    }
+
+    void Context::finish() {
+        if(!finished) {
+            startPhase(phase);
+            finished = true;
+        }
+    }
+
+    std::map<std::string, Solver>& registry() {
+        static std::map<std::string, Solver> days;
+        return days;
+    }
+
+    Registration::Registration(const std::string& day, Solver solver) {
+        if(!registry().emplace(day, solver).second) {
+            throw std::invalid_argument("Day registered twice: " + day);
+        }
+    }
+
+    int runStandalone(Solver solver) {
+        Context context(std::cout);
+        solver(context);
+        return 0;
+    }
+}
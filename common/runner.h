@@ -0,0 +1,66 @@
+#ifndef RUNNER_H_
+#define RUNNER_H_
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <ostream>
+#include <string>
+
+// every day is a solve function that writes its answers to context.out and marks where its phases begin
+// built on its own a day gets a main that runs it against std::cout, built with AOC_RUNNER it is registered
+// with the runner instead, so every day can be linked into one binary
+namespace runner {
+    enum class Phase { Parse, Part1, Part2 };
+    constexpr size_t NUMBER_OF_PHASES = 3;
+
+    struct PhaseResult {
+        double milliseconds = 0.0;
+        uint64_t allocations = 0u;
+    };
+
+    class Context {
+    public:
+        // allocationCounter returns a running total of allocations, left empty allocations aren't counted
+        explicit Context(std::ostream& out, std::function<uint64_t()> allocationCounter = {});
+
+        // ends the phase in progress and starts the next one, a day starts out in Phase::Parse
+        void startPhase(Phase phase);
+        void finish();
+
+        const std::array<PhaseResult, NUMBER_OF_PHASES>& getResults() const { return results; }
+
+        std::ostream& out;
+
+    private:
+        uint64_t countAllocations() const;
+
+        std::function<uint64_t()> allocationCounter;
+        std::array<PhaseResult, NUMBER_OF_PHASES> results;
+        Phase phase = Phase::Parse;
+        std::chrono::steady_clock::time_point phaseStart;
+        uint64_t phaseStartAllocations = 0u;
+        bool finished = false;
+    };
+
+    using Solver = void (*)(Context&);
+
+    // days by name, in order
+    std::map<std::string, Solver>& registry();
+
+    struct Registration {
+        Registration(const std::string& day, Solver solver);
+    };
+
+    int runStandalone(Solver solver);
+}
+
+#ifdef AOC_RUNNER
+#define AOC_DAY(day, solver) static const runner::Registration aocRegistration(day, solver);
+#else
+#define AOC_DAY(day, solver) int main() { return runner::runStandalone(solver); }
+#endif
+
+#endif
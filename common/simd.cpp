@@ -0,0 +1,17 @@
+#include "simd.h"
+
+namespace simd {
+    // __builtin_cpu_supports only takes a string literal, hence the switch
+    bool supports(Feature feature) {
+#ifdef AOC_SIMD
+        switch(feature) {
+            case Feature::Sse2: return __builtin_cpu_supports("sse2");
+            case Feature::Ssse3: return __builtin_cpu_supports("ssse3");
+            case Feature::Avx2: return __builtin_cpu_supports("avx2");
+            case Feature::Avx512bw: return __builtin_cpu_supports("avx512bw");
+        }
+#endif
+        static_cast<void>(feature);
+        return false;
+    }
+}
@@ -0,0 +1,39 @@
+#ifndef SIMD_H_
+#define SIMD_H_
+
+#include <initializer_list>
+
+// vector kernels are built for their own instruction set with __attribute__((target(...))) and one is picked at run time,
+// so a binary built for any x86-64 still uses the widest instructions the machine has
+// kernels go inside #ifdef AOC_SIMD, since the intrinsics only exist on x86-64
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define AOC_SIMD 1
+#endif
+
+namespace simd {
+    enum class Feature {
+        Sse2, Ssse3, Avx2, Avx512bw
+    };
+
+    bool supports(Feature feature);
+
+    template<typename Function>
+    struct Variant {
+        Feature feature;
+        Function function;
+    };
+
+    // the first variant this CPU can run, so list them widest first, otherwise fallback
+    template<typename Function>
+    Function select(std::initializer_list<Variant<Function>> variants, Function fallback) {
+        for(const auto& variant: variants) {
+            if(supports(variant.feature)) {
+                return variant.function;
+            }
+        }
+        return fallback;
+    }
+}
+
+#endif
@@ -0,0 +1,98 @@
+#include "spiral.h"
+
+#include <cmath>
+#include <stdexcept>
+
+#include "simd.h"
+
+namespace spiral {
+    namespace {
+        // the double square root is only a guess for numbers past 2^52, so it is nudged onto the exact answer
+        uint64_t integerSqrt(uint64_t value) {
+            auto root = static_cast<uint64_t>(std::sqrt(static_cast<double>(value)));
+            while(root > UINT32_MAX || root * root > value) {
+                --root;
+            }
+            while(root < UINT32_MAX && (root + 1) * (root + 1) <= value) {
+                ++root;
+            }
+            return root;
+        }
+
+        // distance throws on square 0 itself, so there is never anything left to flag
+        bool distancesScalar(const uint32_t* squares, uint32_t* out, size_t size) {
+            for(auto i = 0u; i < size; ++i) {
+                out[i] = static_cast<uint32_t>(distance(squares[i]));
+            }
+            return true;
+        }
+
+#ifdef AOC_SIMD
+        // four squares at a time in doubles, which hold every value involved exactly
+        // square 1 has no ring to speak of so it is blended in at the end, and square 0 is flagged for the caller to reject
+        __attribute__((target("avx2")))
+        bool distancesAvx2(const uint32_t* squares, uint32_t* out, size_t size) {
+            const auto one = _mm256_set1_pd(1.0);
+            const auto two = _mm256_set1_pd(2.0);
+            const auto half = _mm256_set1_pd(0.5);
+            const auto signBit = _mm_set1_epi32(INT32_MIN);
+            const auto unsignedOffset = _mm256_set1_pd(2147483648.0);
+            auto zeros = _mm256_setzero_pd();
+            size_t i = 0u;
+            for(; i + 4 <= size; i += 4) {
+                // there is no unsigned conversion, so flip the top bit, convert as signed and add it back on
+                const auto raw = _mm_loadu_si128(reinterpret_cast<const __m128i*>(squares + i));
+                const auto square = _mm256_add_pd(_mm256_cvtepi32_pd(_mm_xor_si128(raw, signBit)), unsignedOffset);
+                zeros = _mm256_or_pd(zeros, _mm256_cmp_pd(square, _mm256_setzero_pd(), _CMP_EQ_OQ));
+
+                const auto index = _mm256_sub_pd(square, one);
+                const auto root = _mm256_floor_pd(_mm256_sqrt_pd(index));
+                const auto ring = _mm256_floor_pd(_mm256_mul_pd(_mm256_add_pd(root, one), half));
+                const auto innerWidth = _mm256_sub_pd(_mm256_mul_pd(ring, two), one);
+                const auto position = _mm256_sub_pd(index, _mm256_mul_pd(innerWidth, innerWidth));
+                const auto sideLength = _mm256_mul_pd(ring, two);
+                const auto offset = _mm256_sub_pd(position, _mm256_mul_pd(sideLength, _mm256_floor_pd(_mm256_div_pd(position, sideLength))));
+                const auto fromMidpoint = _mm256_andnot_pd(_mm256_set1_pd(-0.0), _mm256_sub_pd(offset, _mm256_sub_pd(ring, one)));
+                auto result = _mm256_add_pd(ring, fromMidpoint);
+                result = _mm256_blendv_pd(result, _mm256_setzero_pd(), _mm256_cmp_pd(square, one, _CMP_LE_OQ));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm256_cvttpd_epi32(result));
+            }
+            distancesScalar(squares + i, out + i, size - i);
+            return _mm256_movemask_pd(zeros) == 0;
+        }
+#endif
+
+        using DistancesFunction = bool (*)(const uint32_t*, uint32_t*, size_t);
+    }
+
+    uint64_t distance(uint64_t square) {
+        if(square == 0u) {
+            throw std::invalid_argument("There is no square 0 on the spiral");
+        }
+        if(square == 1u) {
+            return 0u;
+        }
+        // squares are numbered from 1, so the index of a square is one less, and ring r starts at index (2r - 1)^2
+        const auto index = square - 1;
+        const auto ring = (integerSqrt(index) + 1) / 2;
+        const auto position = index - (2 * ring - 1) * (2 * ring - 1);
+        const auto offset = position % (2 * ring);
+        // the middle of each side is at offset r - 1, straight out from square 1
+        const auto fromMidpoint = offset > ring - 1 ? offset - (ring - 1) : (ring - 1) - offset;
+        return ring + fromMidpoint;
+    }
+
+    void distances(std::span<const uint32_t> squares, std::span<uint32_t> out) {
+        if(squares.size() != out.size()) {
+            throw std::invalid_argument("Output is not the same size as the squares");
+        }
+        static const auto kernel = simd::select<DistancesFunction>({
+#ifdef AOC_SIMD
+            {simd::Feature::Avx2, distancesAvx2},
+#endif
+        }, distancesScalar);
+        if(!kernel(squares.data(), out.data(), squares.size())) {
+            throw std::invalid_argument("There is no square 0 on the spiral");
+        }
+    }
+}
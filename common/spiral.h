@@ -0,0 +1,19 @@
+#ifndef SPIRAL_H_
+#define SPIRAL_H_
+
+#include <cstdint>
+#include <span>
+
+// the spiral memory from day 03: square 1 in the middle and the numbers winding outwards anticlockwise
+// ring r (r >= 1) holds squares (2r - 1)^2 + 1 to (2r + 1)^2, four sides of 2r squares each ending in a corner
+namespace spiral {
+    // manhattan distance from a square back to square 1, worked out from the ring and the offset along its side
+    // throws std::invalid_argument for square 0, which isn't on the spiral
+    uint64_t distance(uint64_t square);
+
+    // distance for every square at once, out must be the same size as squares
+    // a block of squares is worked out together with AVX2 where the CPU has it, otherwise it is distance per square
+    void distances(std::span<const uint32_t> squares, std::span<uint32_t> out);
+}
+
+#endif
@@ -0,0 +1,205 @@
+#include <exception>
+#include <fstream>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "concurrency.h"
+#include "instrument.h"
+#include "runner.h"
+
+// every day linked into one binary, run in order or all at once, with timings written out as JSON or CSV
+// usage: aoc-runner [--parallel] [--format json|csv] [day...]
+
+namespace {
+    struct DayResult {
+        std::string day;
+        std::array<runner::PhaseResult, runner::NUMBER_OF_PHASES> phases;
+        uint64_t peakRssKilobytes = 0u;
+        std::string output;
+        std::string error;
+    };
+
+    // writing 5 to clear_refs resets the peak resident set size the kernel reports as VmHWM
+    void resetPeakRss() {
+        std::ofstream clearRefs("/proc/self/clear_refs");
+        clearRefs << "5";
+    }
+
+    uint64_t getPeakRssKilobytes() {
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while(std::getline(status, line)) {
+            if(line.starts_with("VmHWM:")) {
+                return std::stoull(line.substr(6));
+            }
+        }
+        return 0u;
+    }
+
+    // when days run in parallel the peak is never reset, so each day reports the process peak so far
+    DayResult runDay(const std::string& day, runner::Solver solver, bool isParallel) {
+        DayResult result { day };
+        if(!isParallel) {
+            resetPeakRss();
+        }
+        std::ostringstream out;
+        runner::Context context(out, instrument::allocationCount);
+        try {
+            solver(context);
+        }
+        catch(std::exception& e) {
+            result.error = e.what();
+        }
+        context.finish();
+        result.phases = context.getResults();
+        result.peakRssKilobytes = getPeakRssKilobytes();
+        result.output = out.str();
+        return result;
+    }
+
+    std::string escapeJson(const std::string& text) {
+        std::ostringstream out;
+        for(auto c: text) {
+            switch(c) {
+                case '"': out << "\\\""; break;
+                case '\\': out << "\\\\"; break;
+                case '\n': out << "\\n"; break;
+                case '\t': out << "\\t"; break;
+                default:
+                    if(static_cast<unsigned char>(c) < 0x20) {
+                        out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec << std::setfill(' ');
+                    }
+                    else {
+                        out << c;
+                    }
+            }
+        }
+        return out.str();
+    }
+
+    // a quoted CSV field only needs its own quotes doubled, commas and newlines are safe inside the quotes
+    constexpr std::string quoteCsv(std::string_view text) {
+        std::string quoted = "\"";
+        for(auto c: text) {
+            quoted += c;
+            if(c == '"') {
+                quoted += '"';
+            }
+        }
+        return quoted + "\"";
+    }
+
+    static_assert(quoteCsv("") == "\"\"");
+    static_assert(quoteCsv("Not a lowercase word: b\"c") == "\"Not a lowercase word: b\"\"c\"");
+    static_assert(quoteCsv("a,\"\"\nb") == "\"a,\"\"\"\"\nb\"");
+
+    double getTotalMilliseconds(const DayResult& result) {
+        auto total = 0.0;
+        for(const auto& phase: result.phases) {
+            total += phase.milliseconds;
+        }
+        return total;
+    }
+
+    void writeJson(std::ostream& out, const std::vector<DayResult>& results) {
+        const char* phaseNames[] = {"parse", "part1", "part2"};
+        out << std::fixed << std::setprecision(3) << "[\n";
+        for(auto i = 0u; i < results.size(); ++i) {
+            const auto& result = results[i];
+            out << "  {\"day\": \"" << result.day << "\"";
+            for(auto phase = 0u; phase < runner::NUMBER_OF_PHASES; ++phase) {
+                out << ", \"" << phaseNames[phase] << "Ms\": " << result.phases[phase].milliseconds;
+            }
+            out << ", \"totalMs\": " << getTotalMilliseconds(result);
+            for(auto phase = 0u; phase < runner::NUMBER_OF_PHASES; ++phase) {
+                out << ", \"" << phaseNames[phase] << "Allocations\": " << result.phases[phase].allocations;
+            }
+            out << ", \"peakRssKb\": " << result.peakRssKilobytes;
+            out << ", \"output\": \"" << escapeJson(result.output) << "\"";
+            if(!result.error.empty()) {
+                out << ", \"error\": \"" << escapeJson(result.error) << "\"";
+            }
+            out << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        out << "]\n";
+    }
+
+    void writeCsv(std::ostream& out, const std::vector<DayResult>& results) {
+        out << "day,parse_ms,part1_ms,part2_ms,total_ms,parse_allocations,part1_allocations,part2_allocations,peak_rss_kb,error\n";
+        out << std::fixed << std::setprecision(3);
+        for(const auto& result: results) {
+            out << result.day;
+            for(const auto& phase: result.phases) {
+                out << "," << phase.milliseconds;
+            }
+            out << "," << getTotalMilliseconds(result);
+            for(const auto& phase: result.phases) {
+                out << "," << phase.allocations;
+            }
+            out << "," << result.peakRssKilobytes << "," << quoteCsv(result.error) << "\n";
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    auto isParallel = false;
+    std::string format = "json";
+    std::vector<std::string> days;
+    for(auto i = 1; i < argc; ++i) {
+        const std::string argument = argv[i];
+        if(argument == "--parallel") {
+            isParallel = true;
+        }
+        else if(argument == "--format" && i + 1 < argc) {
+            format = argv[++i];
+        }
+        else {
+            days.push_back(argument.size() == 1 ? "0" + argument : argument);
+        }
+    }
+    if(format != "json" && format != "csv") {
+        std::cerr << "Unknown format: " << format << "\n";
+        return 1;
+    }
+
+    const auto& registry = runner::registry();
+    if(days.empty()) {
+        for(const auto& [day, solver]: registry) {
+            days.push_back(day);
+        }
+    }
+    for(const auto& day: days) {
+        if(!registry.contains(day)) {
+            std::cerr << "Unknown day: " << day << "\n";
+            return 1;
+        }
+    }
+
+    // allocation counts are for the whole process, so they overlap between days run in parallel
+    std::vector<DayResult> results;
+    if(isParallel) {
+        std::vector<std::future<DayResult>> futures;
+        for(const auto& day: days) {
+            futures.push_back(concurrency::sharedPool().submit([&day, &registry]() { return runDay(day, registry.at(day), true); }));
+        }
+        results = concurrency::getAll(futures);
+    }
+    else {
+        for(const auto& day: days) {
+            results.push_back(runDay(day, registry.at(day), false));
+        }
+    }
+
+    if(format == "json") {
+        writeJson(std::cout, results);
+    }
+    else {
+        writeCsv(std::cout, results);
+    }
+    return 0;
+}